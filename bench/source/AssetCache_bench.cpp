@@ -0,0 +1,71 @@
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Renderer/Scene/AssetCache.h"
+
+namespace
+{
+    using namespace exage::Renderer;
+
+    auto makePaths(size_t count) -> std::vector<std::string>
+    {
+        std::vector<std::string> paths;
+        for (size_t i = 0; i < count; i++)
+        {
+            paths.push_back("assets/environment/materials/material_" + std::to_string(i)
+                            + ".exmat");
+        }
+        return paths;
+    }
+
+    // What the AssetCache used to do: hash the whole path on every lookup
+    void pathLookup(benchmark::State& state)
+    {
+        std::vector<std::string> paths = makePaths(static_cast<size_t>(state.range(0)));
+
+        std::unordered_map<std::string, GPUMaterial> materials;
+        for (const std::string& path : paths)
+        {
+            materials.emplace(path, GPUMaterial {.path = path});
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (const std::string& path : paths)
+            {
+                benchmark::DoNotOptimize(&materials[path]);
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    void handleLookup(benchmark::State& state)
+    {
+        std::vector<std::string> paths = makePaths(static_cast<size_t>(state.range(0)));
+
+        AssetCache cache;
+        std::vector<AssetHandle> handles;
+        for (const std::string& path : paths)
+        {
+            handles.push_back(internAsset(path));
+            cache.addMaterial(GPUMaterial {.path = path, .handle = handles.back()});
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (AssetHandle handle : handles)
+            {
+                benchmark::DoNotOptimize(&cache.getMaterial(handle));
+            }
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+}  // namespace
+
+BENCHMARK(pathLookup)->Arg(1'000)->Arg(100'000);
+BENCHMARK(handleLookup)->Arg(1'000)->Arg(100'000);
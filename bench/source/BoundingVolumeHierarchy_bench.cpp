@@ -0,0 +1,122 @@
+#include <random>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Renderer/Scene/BoundingVolumeHierarchy.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    // Unit boxes scattered over a cube, each with a world matrix, like a scene of static meshes
+    struct Scattered
+    {
+        std::vector<glm::mat4> matrices;
+        std::vector<Entity> entities;
+        AABB localBounds {glm::vec4 {-0.5F, -0.5F, -0.5F, 0.F},
+                          glm::vec4 {0.5F, 0.5F, 0.5F, 0.F}};
+
+        explicit Scattered(size_t count)
+        {
+            std::mt19937 random {7};
+            std::uniform_real_distribution<float> position {-500.F, 500.F};
+
+            for (size_t i = 0; i < count; i++)
+            {
+                glm::mat4 matrix {1.F};
+                matrix[3] = glm::vec4 {position(random), position(random), position(random), 1.F};
+                matrices.push_back(matrix);
+                entities.push_back(static_cast<Entity>(static_cast<uint32_t>(i)));
+            }
+        }
+    };
+
+    auto rayHitsBox(glm::vec3 origin, glm::vec3 direction, const AABB& box) -> bool
+    {
+        glm::vec3 const t1 = (glm::vec3 {box.min} - origin) / direction;
+        glm::vec3 const t2 = (glm::vec3 {box.max} - origin) / direction;
+        glm::vec3 const entries = glm::min(t1, t2);
+        glm::vec3 const exits = glm::max(t1, t2);
+        return std::max({entries.x, entries.y, entries.z, 0.F})
+            <= std::min({exits.x, exits.y, exits.z});
+    }
+
+    // What mouse picking used to do: invert every model matrix and test in local space
+    void linearRayScan(benchmark::State& state)
+    {
+        Scattered scene {static_cast<size_t>(state.range(0))};
+        glm::vec3 const origin {0.F, 0.F, -1000.F};
+        glm::vec3 const direction {0.F, 0.F, 1.F};
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            size_t hits = 0;
+            for (const glm::mat4& matrix : scene.matrices)
+            {
+                glm::mat4 const inverse = glm::inverse(matrix);
+                glm::vec3 const localOrigin = glm::vec3 {inverse * glm::vec4 {origin, 1.F}};
+                glm::vec3 const localDirection = glm::vec3 {inverse * glm::vec4 {direction, 0.F}};
+                hits += rayHitsBox(localOrigin, localDirection, scene.localBounds) ? 1 : 0;
+            }
+            benchmark::DoNotOptimize(hits);
+        }
+    }
+
+    void hierarchyRayQuery(benchmark::State& state)
+    {
+        Scattered scene {static_cast<size_t>(state.range(0))};
+        glm::vec3 const origin {0.F, 0.F, -1000.F};
+        glm::vec3 const direction {0.F, 0.F, 1.F};
+
+        BoundingVolumeHierarchy hierarchy;
+        for (size_t i = 0; i < scene.entities.size(); i++)
+        {
+            hierarchy.update(scene.entities[i],
+                             transformAABB(scene.localBounds, scene.matrices[i]));
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            size_t hits = 0;
+            hierarchy.queryRay(origin,
+                               direction,
+                               std::numeric_limits<float>::max(),
+                               [&](Entity, float) -> float
+                               {
+                                   hits++;
+                                   return std::numeric_limits<float>::max();
+                               });
+            benchmark::DoNotOptimize(hits);
+        }
+    }
+
+    // One in a hundred entities moves a little every frame
+    void hierarchyIncrementalUpdate(benchmark::State& state)
+    {
+        Scattered scene {static_cast<size_t>(state.range(0))};
+
+        BoundingVolumeHierarchy hierarchy;
+        for (size_t i = 0; i < scene.entities.size(); i++)
+        {
+            hierarchy.update(scene.entities[i],
+                             transformAABB(scene.localBounds, scene.matrices[i]));
+        }
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t i = 0; i < scene.entities.size(); i += 100)
+            {
+                scene.matrices[i][3].x += 0.5F;
+                hierarchy.update(scene.entities[i],
+                                 transformAABB(scene.localBounds, scene.matrices[i]));
+            }
+            benchmark::ClobberMemory();
+        }
+    }
+}  // namespace
+
+BENCHMARK(linearRayScan)->Arg(10'000)->Arg(100'000);
+BENCHMARK(hierarchyRayQuery)->Arg(10'000)->Arg(100'000);
+BENCHMARK(hierarchyIncrementalUpdate)->Arg(10'000)->Arg(100'000);
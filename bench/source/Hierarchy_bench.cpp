@@ -0,0 +1,237 @@
+#include <benchmark/benchmark.h>
+
+#include "SceneShapes.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::bench;
+
+    void updateHierarchy(benchmark::State& state,
+                         TransformPropagation propagation,
+                         HierarchyStorage storage = HierarchyStorage::eLinked)
+    {
+        Scene scene;
+        buildForest(scene, state);
+        scene.setTransformPropagation(propagation);
+        scene.setHierarchyStorage(storage);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            scene.markAllTransformsDirty();
+            scene.updateHierarchy(true);
+            benchmark::ClobberMemory();
+        }
+
+        auto transformCount = static_cast<int64_t>(scene.registry().view<Transform3D>().size());
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * transformCount);
+    }
+
+    void recursiveUpdate(benchmark::State& state)
+    {
+        updateHierarchy(state, TransformPropagation::eRecursive);
+    }
+
+    void flattenedUpdate(benchmark::State& state)
+    {
+        updateHierarchy(state, TransformPropagation::eFlattened);
+    }
+
+    void depthFirstUpdate(benchmark::State& state)
+    {
+        updateHierarchy(state, TransformPropagation::eRecursive, HierarchyStorage::eDepthFirst);
+    }
+
+    void compactUpdate(benchmark::State& state)
+    {
+        Scene scene;
+        buildForest(scene, state);
+
+        auto& registry = scene.registry();
+        std::vector<Entity> entities;
+        for (Entity entity : registry.view<Transform3D>())
+        {
+            entities.push_back(entity);
+        }
+
+        for (Entity entity : entities)
+        {
+            const auto& transform = registry.get<Transform3D>(entity);
+            registry.emplace<CompactTransform>(entity,
+                                               transform.position,
+                                               transform.rotation.getQuaternion(),
+                                               transform.scale);
+        }
+        registry.clear<Transform3D>();
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            scene.markAllTransformsDirty();
+            scene.updateHierarchy(true);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                                * static_cast<int64_t>(entities.size()));
+    }
+
+    // Mostly static scene: one root in every hundred moves per frame
+    void sparseUpdate(benchmark::State& state)
+    {
+        Scene scene;
+        buildForest(scene, state);
+        scene.updateHierarchy(true);
+
+        std::vector<Entity> moving;
+        scene.forEachRoot(
+            [&](Entity root)
+            {
+                if (moving.size() * 100 < static_cast<size_t>(state.range(0)))
+                {
+                    moving.push_back(root);
+                }
+            });
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (Entity root : moving)
+            {
+                scene.updateTransform(root,
+                                      [](Transform3D& transform) { transform.position.x += 1.F; });
+            }
+            scene.updateHierarchy(true);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // Per-frame bookkeeping of a scene where one entity is reparented each frame
+    void rootMaintenance(benchmark::State& state)
+    {
+        Scene scene;
+        auto const entityCount = static_cast<size_t>(state.range(0));
+        buildForest(scene, entityCount / 10, 2, 9);
+        scene.updateHierarchy(true);
+
+        Entity moving = scene.createEntity();
+        Entity parent = entt::null;
+        scene.forEachRoot([&](Entity root) { parent = root; });
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            auto const& relationship = scene.getComponent<EntityRelationship>(moving);
+            scene.setParent(moving, relationship.parent != entt::null ? entt::null : parent);
+            scene.updateHierarchy(false);
+            benchmark::ClobberMemory();
+        }
+    }
+
+    // Builds a prefab of `nodeCount` nodes with four children per node, like an imported model
+    auto makePrefab(size_t nodeCount) -> ScenePrefab
+    {
+        ScenePrefab prefab;
+        prefab.parents.resize(nodeCount);
+        prefab.transforms.resize(nodeCount);
+
+        prefab.parents[0] = ScenePrefab::NO_PARENT;
+        for (size_t i = 1; i < nodeCount; i++)
+        {
+            prefab.parents[i] = (i - 1) / 4;
+        }
+        return prefab;
+    }
+
+    void singleInstantiate(benchmark::State& state)
+    {
+        ScenePrefab prefab = makePrefab(static_cast<size_t>(state.range(0)));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Scene scene;
+            std::vector<Entity> entities(prefab.parents.size());
+            for (size_t i = 0; i < entities.size(); i++)
+            {
+                Entity parent = prefab.parents[i] == ScenePrefab::NO_PARENT
+                    ? Entity {entt::null}
+                    : entities[prefab.parents[i]];
+                entities[i] = scene.createEntity(parent);
+                scene.addComponent<Transform3D>(entities[i], prefab.transforms[i]);
+            }
+            benchmark::DoNotOptimize(entities.data());
+        }
+    }
+
+    void bulkInstantiate(benchmark::State& state)
+    {
+        ScenePrefab prefab = makePrefab(static_cast<size_t>(state.range(0)));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Scene scene;
+            std::vector<Entity> entities = scene.instantiate(prefab);
+            benchmark::DoNotOptimize(entities.data());
+        }
+    }
+
+    // Random-looking but reproducible transforms for the matrix kernels
+    auto makeTransforms(size_t count) -> std::vector<Transform3D>
+    {
+        std::vector<Transform3D> transforms(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            auto const offset = static_cast<float>(i % 97);
+            transforms[i].position = glm::vec3(offset, -offset, 0.5F * offset);
+            transforms[i].scale = glm::vec3(1.F + 0.01F * offset);
+            transforms[i].rotation = Rotation3D {glm::vec3(0.01F * offset, 0.2F, -0.3F)};
+        }
+        return transforms;
+    }
+
+    void glmTransformMatrices(benchmark::State& state)
+    {
+        std::vector<Transform3D> transforms = makeTransforms(static_cast<size_t>(state.range(0)));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (auto& transform : transforms)
+            {
+                transform.matrix = glm::translate(transform.position)
+                    * transform.rotation.getRotationMatrix() * glm::scale(transform.scale);
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    void batchedTransformMatrices(benchmark::State& state)
+    {
+        std::vector<Transform3D> transforms = makeTransforms(static_cast<size_t>(state.range(0)));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            calculateTransformMatrices(transforms);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * state.range(0));
+    }
+
+    // ~20k and ~220k entities, wide and deep
+    void hierarchyShapes(benchmark::internal::Benchmark* benchmark)
+    {
+        applyShapes(benchmark, {{20, 4, 10}, {200, 4, 10}, {1000, 18, 1}});
+    }
+}  // namespace
+
+BENCHMARK(recursiveUpdate)->Apply(hierarchyShapes);
+BENCHMARK(flattenedUpdate)->Apply(hierarchyShapes)->UseRealTime();
+BENCHMARK(depthFirstUpdate)->Apply(hierarchyShapes);
+BENCHMARK(compactUpdate)->Apply(hierarchyShapes);
+BENCHMARK(sparseUpdate)->Apply(hierarchyShapes);
+BENCHMARK(singleInstantiate)->Arg(50'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(bulkInstantiate)->Arg(50'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(glmTransformMatrices)->Arg(100'000);
+BENCHMARK(batchedTransformMatrices)->Arg(100'000);
+BENCHMARK(rootMaintenance)->Arg(10'000)->Arg(100'000)->Arg(1'000'000);
@@ -0,0 +1,134 @@
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Renderer/Scene/Loader/Converter.h"
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    constexpr size_t NODE_COUNT = 48;
+    constexpr size_t MESH_COUNT = 4;
+
+    // An imported prop: a root with a chain of nodes below it, cycling through a few meshes
+    struct ImportedModel
+    {
+        std::vector<GPUStaticMesh> meshes;
+        std::vector<AssetImportResult2::Node> nodes;
+        std::vector<size_t> rootNodes {0};
+
+        ImportedModel()
+        {
+            for (size_t i = 0; i < MESH_COUNT; i++)
+            {
+                GPUStaticMesh& mesh = meshes.emplace_back();
+                mesh.path = "assets/props/debris/debris_fragment_" + std::to_string(i) + ".exmesh";
+                mesh.handle = internAsset(mesh.path);
+                mesh.aabb = {glm::vec4 {-0.5F, -0.5F, -0.5F, 0.F},
+                             glm::vec4 {0.5F, 0.5F, 0.5F, 0.F}};
+            }
+
+            for (size_t i = 0; i < NODE_COUNT; i++)
+            {
+                AssetImportResult2::Node& node = nodes.emplace_back();
+                node.transform.position = glm::vec3(0.F, 0.5F, 0.F);
+                node.meshIndex = i % MESH_COUNT;
+                node.parentIndex = i == 0 ? ScenePrefab::NO_PARENT : i - 1;
+            }
+        }
+
+        [[nodiscard]] auto getInfo() noexcept -> AssetSceneImportInfo
+        {
+            return {.meshes = meshes, .rootNodes = rootNodes, .nodes = nodes};
+        }
+    };
+
+    // Keeps track of what the registry has allocated
+    class CountingResource : public std::pmr::memory_resource
+    {
+      public:
+        size_t outstanding = 0;
+
+      private:
+        auto do_allocate(size_t bytes, size_t alignment) -> void* override
+        {
+            outstanding += bytes;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+        {
+            outstanding -= bytes;
+            std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    // Places the model `count` times into a fresh scene per iteration
+    template<typename F>
+    void placeModel(benchmark::State& state, F&& place)
+    {
+        auto const count = static_cast<size_t>(state.range(0));
+        size_t registryBytes = 0;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            CountingResource resource;
+            Scene scene {&resource};
+
+            for (size_t i = 0; i < count; i++)
+            {
+                Transform3D transform {};
+                transform.position = glm::vec3(static_cast<float>(i % 1000), 0.F, 0.F);
+                place(scene, transform);
+            }
+            scene.updateHierarchy(true);
+
+            registryBytes = resource.outstanding;
+        }
+
+        state.counters["registryBytes"] = static_cast<double>(registryBytes);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                                * static_cast<int64_t>(count));
+    }
+
+    // What placing a prop used to take: an entity, transform and mesh for every node
+    void importSceneCopies(benchmark::State& state)
+    {
+        ImportedModel model;
+        AssetSceneImportInfo info = model.getInfo();
+
+        placeModel(state,
+                   [&](Scene& scene, const Transform3D& transform)
+                   {
+                       Entity root = scene.createEntity();
+                       scene.addComponent<Transform3D>(root, transform);
+                       importScene(info, scene, root);
+                   });
+    }
+
+    void prefabPlacements(benchmark::State& state)
+    {
+        ImportedModel model;
+        Prefab prefab = makePrefab(model.getInfo(), "assets/props/debris/debris.exprefab");
+
+        placeModel(state,
+                   [&](Scene& scene, const Transform3D& transform)
+                   { placePrefab(prefab, scene, transform); });
+    }
+}  // namespace
+
+BENCHMARK(importSceneCopies)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(prefabPlacements)->Arg(1'000)->Arg(10'000)->Unit(benchmark::kMillisecond);
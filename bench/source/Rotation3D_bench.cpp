@@ -0,0 +1,107 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Scene/Rotation3D.h"
+
+namespace
+{
+    using namespace exage;
+
+    constexpr size_t ROTATION_COUNT = 1'000'000;
+
+    auto makeEulers() -> std::vector<glm::vec3>
+    {
+        std::vector<glm::vec3> eulers(ROTATION_COUNT);
+        for (size_t i = 0; i < ROTATION_COUNT; i++)
+        {
+            auto const offset = static_cast<float>(i % 1000);
+            eulers[i] = glm::vec3(0.01F * offset, -0.02F * offset, 0.5F + 0.003F * offset);
+        }
+        return eulers;
+    }
+
+    auto makeQuaternions() -> std::vector<glm::quat>
+    {
+        std::vector<glm::vec3> eulers = makeEulers();
+        std::vector<glm::quat> quaternions(ROTATION_COUNT);
+        for (size_t i = 0; i < ROTATION_COUNT; i++)
+        {
+            quaternions[i] = Rotation3D {eulers[i]}.getQuaternion();
+        }
+        return quaternions;
+    }
+
+    void setItemsProcessed(benchmark::State& state)
+    {
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                                * static_cast<int64_t>(ROTATION_COUNT));
+    }
+
+    void scalarQuaternionsToMatrices(benchmark::State& state)
+    {
+        std::vector<glm::quat> quaternions = makeQuaternions();
+        std::vector<glm::mat3> matrices(ROTATION_COUNT);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t i = 0; i < ROTATION_COUNT; i++)
+            {
+                matrices[i] = glm::toMat3(quaternions[i]);
+            }
+            benchmark::ClobberMemory();
+        }
+
+        setItemsProcessed(state);
+    }
+
+    void batchedQuaternionsToMatrices(benchmark::State& state)
+    {
+        std::vector<glm::quat> quaternions = makeQuaternions();
+        std::vector<glm::mat3> matrices(ROTATION_COUNT);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            quaternionsToMatrices(quaternions, matrices);
+            benchmark::ClobberMemory();
+        }
+
+        setItemsProcessed(state);
+    }
+
+    void scalarEulerToQuaternions(benchmark::State& state)
+    {
+        std::vector<glm::vec3> eulers = makeEulers();
+        std::vector<glm::quat> quaternions(ROTATION_COUNT);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t i = 0; i < ROTATION_COUNT; i++)
+            {
+                quaternions[i] = Rotation3D {eulers[i]}.getQuaternion();
+            }
+            benchmark::ClobberMemory();
+        }
+
+        setItemsProcessed(state);
+    }
+
+    void batchedEulerToQuaternions(benchmark::State& state)
+    {
+        std::vector<glm::vec3> eulers = makeEulers();
+        std::vector<glm::quat> quaternions(ROTATION_COUNT);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            eulerToQuaternions(eulers, quaternions);
+            benchmark::ClobberMemory();
+        }
+
+        setItemsProcessed(state);
+    }
+}  // namespace
+
+BENCHMARK(scalarQuaternionsToMatrices)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchedQuaternionsToMatrices)->Unit(benchmark::kMillisecond);
+BENCHMARK(scalarEulerToQuaternions)->Unit(benchmark::kMillisecond);
+BENCHMARK(batchedEulerToQuaternions)->Unit(benchmark::kMillisecond);
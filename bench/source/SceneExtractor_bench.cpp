@@ -0,0 +1,99 @@
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Renderer/SceneExtractor.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    // `count` meshes in chains of four, of which every hundredth root moves each frame
+    auto buildMeshes(Scene& scene, size_t count) -> std::vector<Entity>
+    {
+        std::vector<Entity> moving;
+
+        std::vector<AssetHandle> meshes;
+        for (size_t i = 0; i < 16; i++)
+        {
+            meshes.push_back(internAsset("mesh" + std::to_string(i)));
+        }
+
+        Entity parent = entt::null;
+        for (size_t i = 0; i < count; i++)
+        {
+            parent = scene.createEntity(i % 4 == 0 ? Entity {entt::null} : parent);
+            scene.addComponent<Transform3D>(parent).position = glm::vec3(static_cast<float>(i));
+            scene.addComponent<StaticMeshComponent>(parent, meshes[i % meshes.size()]);
+
+            if (i % 400 == 0)
+            {
+                moving.push_back(parent);
+            }
+        }
+
+        scene.updateHierarchy(true);
+        return moving;
+    }
+
+    void moveAll(Scene& scene, const std::vector<Entity>& moving) noexcept
+    {
+        for (Entity entity : moving)
+        {
+            scene.updateTransform(entity,
+                                  [](Transform3D& transform) { transform.position.x += 1.F; });
+        }
+        scene.updateHierarchy(true);
+    }
+
+    // What SceneData used to do: copy the whole storages every frame
+    void storageCopyExtraction(benchmark::State& state)
+    {
+        Scene scene;
+        std::vector<Entity> moving = buildMeshes(scene, static_cast<size_t>(state.range(0)));
+        auto& registry = scene.registry();
+
+        entt::storage<Transform3D> transforms;
+        entt::storage<StaticMeshComponent> meshes;
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            moveAll(scene, moving);
+
+            transforms.clear();
+            meshes.clear();
+
+            auto view = registry.view<Transform3D, StaticMeshComponent>();
+            for (Entity entity : view)
+            {
+                transforms.emplace(entity, view.get<Transform3D>(entity));
+                meshes.emplace(entity, view.get<StaticMeshComponent>(entity));
+            }
+            benchmark::ClobberMemory();
+        }
+    }
+
+    void incrementalExtraction(benchmark::State& state)
+    {
+        Scene scene;
+        std::vector<Entity> moving = buildMeshes(scene, static_cast<size_t>(state.range(0)));
+        SceneExtractor extractor {scene};
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            moveAll(scene, moving);
+            extractor.extract();
+
+            const RenderSnapshot* snapshot = extractor.acquire();
+            benchmark::DoNotOptimize(snapshot->meshes.instances.data());
+            extractor.release(*snapshot);
+        }
+    }
+}  // namespace
+
+BENCHMARK(storageCopyExtraction)->Arg(100'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(incrementalExtraction)->Arg(100'000)->Unit(benchmark::kMillisecond);
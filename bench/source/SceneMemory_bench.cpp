@@ -0,0 +1,96 @@
+#include <cstddef>
+#include <memory_resource>
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Renderer/Scene/Light.h"
+#include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    // Roughly what loading a level does: a few hundred hierarchies of meshes with some lights
+    void loadLevel(Scene& scene, size_t entityCount) noexcept
+    {
+        constexpr size_t CHILDREN_PER_ROOT = 15;
+        constexpr size_t MESH_COUNT = 64;
+
+        std::vector<AssetHandle> meshes;
+        for (size_t i = 0; i < MESH_COUNT; i++)
+        {
+            meshes.push_back(internAsset("mesh" + std::to_string(i)));
+        }
+
+        Entity root = entt::null;
+        for (size_t i = 0; i < entityCount; i++)
+        {
+            Entity const entity =
+                scene.createEntity(i % (CHILDREN_PER_ROOT + 1) == 0 ? entt::null : root);
+            if (i % (CHILDREN_PER_ROOT + 1) == 0)
+            {
+                root = entity;
+            }
+
+            auto& transform = scene.addComponent<Transform3D>(entity);
+            transform.position = glm::vec3(static_cast<float>(i % 100), 0.F, 1.F);
+
+            scene.addComponent<StaticMeshComponent>(entity, meshes[i % MESH_COUNT]);
+            if (i % 32 == 0)
+            {
+                scene.addComponent<PointLight>(entity);
+            }
+        }
+
+        scene.updateHierarchy(true);
+    }
+
+    // Every iteration loads a level into a fresh scene, then unloads it
+    template<typename F>
+    void levelChurn(benchmark::State& state, std::pmr::memory_resource* resource, F&& unload)
+    {
+        auto const entityCount = static_cast<size_t>(state.range(0));
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            {
+                Scene scene {resource};
+                loadLevel(scene, entityCount);
+                benchmark::DoNotOptimize(scene.registry().storage<Transform3D>().data());
+            }
+            unload();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                                * static_cast<int64_t>(entityCount));
+    }
+
+    void defaultAllocatorChurn(benchmark::State& state)
+    {
+        levelChurn(state, std::pmr::get_default_resource(), [] {});
+    }
+
+    // Storages recycle each other's blocks, and unloading hands everything back at once
+    void poolChurn(benchmark::State& state)
+    {
+        std::pmr::unsynchronized_pool_resource pool;
+        levelChurn(state, &pool, [&] { pool.release(); });
+    }
+
+    // Nothing is freed until the level unloads, which rewinds the arena into the same buffer
+    void arenaChurn(benchmark::State& state)
+    {
+        std::vector<std::byte> buffer(size_t {256} * 1024 * 1024);
+        std::pmr::monotonic_buffer_resource arena {buffer.data(), buffer.size()};
+        levelChurn(state, &arena, [&] { arena.release(); });
+    }
+}  // namespace
+
+BENCHMARK(defaultAllocatorChurn)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(poolChurn)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
+BENCHMARK(arenaChurn)->Arg(10'000)->Arg(100'000)->Unit(benchmark::kMillisecond);
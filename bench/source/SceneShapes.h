@@ -0,0 +1,118 @@
+#pragma once
+
+#include <charconv>
+#include <cstdlib>
+#include <initializer_list>
+#include <string_view>
+#include <system_error>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+// Synthetic scenes shared by the Scene benchmarks
+namespace exage::bench
+{
+    struct ForestShape
+    {
+        int64_t roots;
+        int64_t depth;
+        int64_t fanOut;
+    };
+
+    // Builds a forest of `roots` trees where every node has `fanOut` children, `depth` levels deep
+    inline void buildForest(Scene& scene, size_t roots, size_t depth, size_t fanOut) noexcept
+    {
+        std::vector<Entity> level;
+        std::vector<Entity> nextLevel;
+
+        for (size_t i = 0; i < roots; i++)
+        {
+            Entity entity = scene.createEntity();
+            scene.addComponent<Transform3D>(entity);
+            level.push_back(entity);
+        }
+
+        for (size_t d = 1; d < depth; d++)
+        {
+            nextLevel.clear();
+            for (Entity parent : level)
+            {
+                for (size_t i = 0; i < fanOut; i++)
+                {
+                    Entity entity = scene.createEntity(parent);
+                    auto& transform = scene.addComponent<Transform3D>(entity);
+                    transform.position = glm::vec3(static_cast<float>(i), 1.F, 0.F);
+                    transform.rotation = Rotation3D {glm::vec3(0.1F, 0.2F, 0.3F)};
+                    nextLevel.push_back(entity);
+                }
+            }
+            std::swap(level, nextLevel);
+        }
+    }
+
+    // Takes the shape from the benchmark's arguments, see applyShapes
+    inline void buildForest(Scene& scene, const benchmark::State& state) noexcept
+    {
+        buildForest(scene,
+                    static_cast<size_t>(state.range(0)),
+                    static_cast<size_t>(state.range(1)),
+                    static_cast<size_t>(state.range(2)));
+    }
+
+    [[nodiscard]] inline auto forestSize(const benchmark::State& state) noexcept -> int64_t
+    {
+        int64_t size = 0;
+        int64_t level = state.range(0);
+        for (int64_t d = 0; d < state.range(1); d++)
+        {
+            size += level;
+            level *= state.range(2);
+        }
+        return size;
+    }
+
+    /* Passes each shape as the {roots, depth, fan-out} arguments of the benchmark. Setting
+     * EXAGE_BENCH_SHAPE to "roots,depth,fanOut" replaces the defaults, so that CI or a profiling
+     * session can pick a size without rebuilding. */
+    inline void applyShapes(benchmark::internal::Benchmark* benchmark,
+                            std::initializer_list<ForestShape> defaults)
+    {
+        benchmark->ArgNames({"roots", "depth", "fanOut"});
+        benchmark->Unit(benchmark::kMillisecond);
+
+        // NOLINTNEXTLINE(concurrency-mt-unsafe): registration runs before main
+        if (const char* variable = std::getenv("EXAGE_BENCH_SHAPE"))
+        {
+            std::string_view const text = variable;
+            std::vector<int64_t> values;
+
+            const char* first = text.data();
+            const char* const last = text.data() + text.size();
+            while (first != last)
+            {
+                int64_t value = 0;
+                auto [next, error] = std::from_chars(first, last, value);
+                if (error != std::errc {} || value <= 0)
+                {
+                    break;
+                }
+                values.push_back(value);
+                first = next != last && *next == ',' ? next + 1 : next;
+            }
+
+            if (values.size() == 3)
+            {
+                benchmark->Args(values);
+                return;
+            }
+        }
+
+        for (auto [roots, depth, fanOut] : defaults)
+        {
+            benchmark->Args({roots, depth, fanOut});
+        }
+    }
+}  // namespace exage::bench
@@ -0,0 +1,168 @@
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "SceneShapes.h"
+#include "exage/Projects/Serialization.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::bench;
+
+    // Every entity of the forest, level by level, so that the leaves come last
+    auto gatherForest(Scene& scene) -> std::vector<Entity>
+    {
+        std::vector<Entity> entities;
+        scene.forEachRoot([&](Entity root) { entities.push_back(root); });
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            scene.forEachChild(entities[i], [&](Entity child) { entities.push_back(child); });
+        }
+        return entities;
+    }
+
+    void createEntity(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Scene scene;
+            buildForest(scene, state);
+            benchmark::DoNotOptimize(scene.registry().storage<Transform3D>().data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    // Flattens everything below the roots onto them, then puts it back, one entity at a time
+    void setParent(benchmark::State& state)
+    {
+        Scene scene;
+        buildForest(scene, state);
+
+        std::vector<Entity> const entities = gatherForest(scene);
+        std::vector<Entity> parents(entities.size());
+        for (size_t i = 0; i < entities.size(); i++)
+        {
+            parents[i] = scene.getComponent<EntityRelationship>(entities[i]).parent;
+        }
+
+        auto const rootCount = static_cast<size_t>(state.range(0));
+        bool flatten = true;
+        for ([[maybe_unused]] auto _ : state)
+        {
+            for (size_t i = rootCount; i < entities.size(); i++)
+            {
+                scene.setParent(entities[i], flatten ? entities[i % rootCount] : parents[i]);
+            }
+            flatten = !flatten;
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations())
+                                * static_cast<int64_t>(entities.size() - rootCount));
+    }
+
+    // Leaves first, so that each call destroys a single entity
+    void destroyEntity(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            Scene scene;
+            buildForest(scene, state);
+            std::vector<Entity> const entities = gatherForest(scene);
+            state.ResumeTiming();
+
+            for (auto it = entities.rbegin(); it != entities.rend(); ++it)
+            {
+                scene.destroyEntity(*it);
+            }
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    // Every subtree queued, then destroyed in one batch
+    void destroyPending(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            Scene scene;
+            buildForest(scene, state);
+            scene.forEachRoot([&](Entity root) { scene.queueDestroy(root); });
+            state.ResumeTiming();
+
+            benchmark::DoNotOptimize(scene.destroyPending());
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    // The first update after building a scene, which also has to lay out the hierarchy
+    void updateHierarchy(benchmark::State& state)
+    {
+        for ([[maybe_unused]] auto _ : state)
+        {
+            state.PauseTiming();
+            Scene scene;
+            buildForest(scene, state);
+            state.ResumeTiming();
+
+            scene.updateHierarchy(true);
+            benchmark::ClobberMemory();
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    void serializeScene(benchmark::State& state)
+    {
+        Scene scene;
+        buildForest(scene, state);
+        scene.updateHierarchy(true);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            auto serialized = Projects::serializeScene(scene);
+            benchmark::DoNotOptimize(serialized);
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    void loadScene(benchmark::State& state)
+    {
+        Scene scene;
+        buildForest(scene, state);
+        scene.updateHierarchy(true);
+        auto const [entityCount, componentData] = Projects::serializeScene(scene);
+
+        for ([[maybe_unused]] auto _ : state)
+        {
+            Scene loaded = Projects::loadScene(entityCount, componentData);
+            benchmark::DoNotOptimize(loaded.registry().storage<Transform3D>().data());
+        }
+
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * forestSize(state));
+    }
+
+    // ~1k, ~10k and ~100k entities, wide and deep
+    void sceneShapes(benchmark::internal::Benchmark* benchmark)
+    {
+        applyShapes(benchmark, {{10, 3, 10}, {100, 3, 10}, {1000, 3, 10}, {100, 100, 1}});
+    }
+}  // namespace
+
+BENCHMARK(createEntity)->Apply(sceneShapes);
+BENCHMARK(setParent)->Apply(sceneShapes);
+BENCHMARK(destroyEntity)->Apply(sceneShapes);
+BENCHMARK(destroyPending)->Apply(sceneShapes);
+BENCHMARK(updateHierarchy)->Apply(sceneShapes);
+BENCHMARK(serializeScene)->Apply(sceneShapes);
+BENCHMARK(loadScene)->Apply(sceneShapes);
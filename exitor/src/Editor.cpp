@@ -156,7 +156,7 @@ namespace exitor
         Graphics::ClearColor const clearColor {.clear = true, .color = {}};
         Graphics::ClearDepthStencil const clearDepthStencil {.clear = false};
 
-        cmd.beginRendering(_frameBuffer, {clearColor}, clearDepthStencil);
+        cmd.beginRendering(_frameBuffer, std::span {&clearColor, 1}, clearDepthStencil);
 
         _imGui->renderMainWindow(cmd);
 
@@ -57,6 +57,7 @@ namespace exitor
             ImGui::DockSpace(dockspaceId, ImVec2(0.0F, 0.0F), dockspaceFlags);
         }
 
+        _level.scene.destroyPending();
         _level.scene.updateHierarchy(true);
 
         menuBar();
@@ -1,11 +1,14 @@
 #pragma once
 
 #include <float.h>
+#include <optional>
 
 #include "Ray.h"
 #include "exage/Renderer/Scene/AssetCache.h"
 #include "exage/Renderer/Scene/Camera.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Renderer/Scene/SpatialIndex.h"
 #include "exage/Scene/Scene.h"
 
 namespace exitor
@@ -110,6 +113,7 @@ namespace exitor
 
     [[nodiscard]] inline auto getSelectedEntity(exage::Renderer::AssetCache& assetCache,
                                                 exage::Scene& scene,
+                                                const exage::Renderer::SpatialIndex& spatialIndex,
                                                 exage::Entity cameraEntity,
                                                 const glm::mat4& viewMatrix,
                                                 const glm::mat4& projectionMatrix,
@@ -127,32 +131,63 @@ namespace exitor
         exage::Entity selectedEntity = entt::null;
         float minDistance = std::numeric_limits<float>::max();
 
-        entt::registry& reg = scene.registry();
-
-        auto view = reg.view<exage::Renderer::StaticMeshComponent, exage::Transform3D>();
-
-        for (auto entity : view)
-        {
-            exage::Renderer::StaticMeshComponent& meshComponent =
-                view.get<exage::Renderer::StaticMeshComponent>(entity);
-            exage::Transform3D& transform = view.get<exage::Transform3D>(entity);
-
-            if (!assetCache.hasMesh(meshComponent.pathHash))
+        // The hierarchy only hands out entities whose world bounds the ray enters before the
+        // closest hit so far; the exact, oriented test is done on those alone
+        spatialIndex.getHierarchy().queryRay(
+            ray.origin,
+            ray.direction,
+            minDistance,
+            [&](exage::Entity entity, float /*entryDistance*/) -> float
             {
-                continue;
-            }
-
-            const exage::Renderer::GPUStaticMesh& mesh = assetCache.getMesh(meshComponent.pathHash);
-
-            auto [intersect, distance] = testRayAABBIntersection(
-                ray, mesh.aabb, transform.globalPosition, transform.globalMatrix);
-
-            if (intersect && distance < minDistance)
-            {
-                minDistance = distance;
-                selectedEntity = entity;
-            }
-        }
+                // The index can still hold entities that lost their transform since its update
+                std::optional<glm::mat4> const worldMatrix = scene.getWorldMatrix(entity);
+                if (!worldMatrix)
+                {
+                    return minDistance;
+                }
+                glm::mat4 const& modelMatrix = *worldMatrix;
+
+                auto testBounds = [&](const exage::Renderer::AABB& aabb, const glm::mat4& model)
+                {
+                    auto [intersect, distance] =
+                        testRayAABBIntersection(ray, aabb, glm::vec3(model[3]), model);
+
+                    if (intersect && distance < minDistance)
+                    {
+                        minDistance = distance;
+                        selectedEntity = entity;
+                    }
+                };
+
+                if (scene.hasComponent<exage::Renderer::StaticMeshComponent>(entity))
+                {
+                    auto& meshComponent =
+                        scene.getComponent<exage::Renderer::StaticMeshComponent>(entity);
+
+                    // The mesh may have been evicted since the index was updated
+                    if (const auto* mesh = assetCache.getMeshIfExists(meshComponent.mesh))
+                    {
+                        testBounds(mesh->aabb, modelMatrix);
+                    }
+                }
+
+                // A prefab placement is picked through any of its meshes
+                if (scene.hasComponent<exage::Renderer::PrefabInstance>(entity))
+                {
+                    auto& instance = scene.getComponent<exage::Renderer::PrefabInstance>(entity);
+                    if (const auto* prefab = assetCache.getPrefabIfExists(instance.prefab))
+                    {
+                        exage::Renderer::forEachPrefabMesh(
+                            *prefab,
+                            instance.overrides,
+                            modelMatrix,
+                            [&](const glm::mat4& model, const exage::Renderer::PrefabMesh& mesh)
+                            { testBounds(mesh.aabb, model); });
+                    }
+                }
+
+                return minDistance;
+            });
 
         return selectedEntity;
     }
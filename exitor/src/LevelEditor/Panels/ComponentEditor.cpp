@@ -64,7 +64,7 @@ namespace exitor
 
         auto& transform = scene.getComponent<exage::Transform3D>(selectedEntity);
 
-        ImGui::DragFloat3("Position", glm::value_ptr(transform.position), 0.1f);
+        bool changed = ImGui::DragFloat3("Position", glm::value_ptr(transform.position), 0.1f);
 
         switch (transform.rotation.getRotationType())
         {
@@ -73,7 +73,7 @@ namespace exitor
                 std::optional<glm::vec3> angleResult = transform.rotation.getEuler();
                 exage::debugAssume(angleResult.has_value(), "Failed to get euler angles");
                 glm::vec3 degrees = glm::degrees(*angleResult);
-                ImGui::DragFloat3("Pitch, Yaw, Roll", glm::value_ptr(degrees), 0.1f);
+                changed |= ImGui::DragFloat3("Pitch, Yaw, Roll", glm::value_ptr(degrees), 0.1f);
                 transform.rotation =
                     exage::Rotation3D {glm::radians(degrees), exage::RotationType::ePitchYawRoll};
                 break;
@@ -83,7 +83,7 @@ namespace exitor
                 std::optional<glm::vec3> angleResult = transform.rotation.getEuler();
                 exage::debugAssume(angleResult.has_value(), "Failed to get euler angles");
                 glm::vec3 degrees = glm::degrees(*angleResult);
-                ImGui::DragFloat3("Yaw, Pitch, Roll", glm::value_ptr(degrees), 0.1f);
+                changed |= ImGui::DragFloat3("Yaw, Pitch, Roll", glm::value_ptr(degrees), 0.1f);
                 transform.rotation =
                     exage::Rotation3D {glm::radians(degrees), exage::RotationType::eYawPitchRoll};
                 break;
@@ -92,7 +92,8 @@ namespace exitor
             {
                 std::optional<glm::quat> quaternionResult = transform.rotation.getQuaternion();
                 exage::debugAssume(quaternionResult.has_value(), "Failed to get quaternion");
-                ImGui::DragFloat4("Quaternion", glm::value_ptr(quaternionResult.value()), 0.1f);
+                changed |= ImGui::DragFloat4(
+                    "Quaternion", glm::value_ptr(quaternionResult.value()), 0.1f);
                 transform.rotation = exage::Rotation3D {quaternionResult.value()};
                 break;
             }
@@ -122,19 +123,27 @@ namespace exitor
             if (ImGui::Selectable("Pitch, Yaw, Roll"))
             {
                 transform.rotation.setRotationType(exage::RotationType::ePitchYawRoll);
+                changed = true;
             }
             if (ImGui::Selectable("Yaw, Pitch, Roll"))
             {
                 transform.rotation.setRotationType(exage::RotationType::eYawPitchRoll);
+                changed = true;
             }
             if (ImGui::Selectable("Quaternion"))
             {
                 transform.rotation.setRotationType(exage::RotationType::eQuaternion);
+                changed = true;
             }
             ImGui::EndCombo();
         }
 
-        ImGui::DragFloat3("Scale", glm::value_ptr(transform.scale), 0.1f);
+        changed |= ImGui::DragFloat3("Scale", glm::value_ptr(transform.scale), 0.1f);
+
+        if (changed)
+        {
+            scene.markTransformDirty(selectedEntity);
+        }
 
         ImGui::Text("Global Position: %f, %f, %f",
                     transform.globalPosition.x,
@@ -184,19 +193,17 @@ namespace exitor
         auto& meshComponent =
             scene.getComponent<exage::Renderer::StaticMeshComponent>(selectedEntity);
 
-        ImGui::Text("Mesh: %s", meshComponent.path.c_str());
+        const std::string& currentPath = exage::Renderer::getAssetPath(meshComponent.mesh);
+        ImGui::Text("Mesh: %s", currentPath.c_str());
 
         // Selection dropdown for mesh
-        if (ImGui::BeginCombo("##Mesh", meshComponent.path.c_str()))
+        if (ImGui::BeginCombo("##Mesh", currentPath.c_str()))
         {
             for (auto& meshPath : project.meshPaths)
             {
                 if (ImGui::Selectable(meshPath.c_str()))
                 {
-                    meshComponent.path = meshPath;
-
-                    std::hash<std::string> hasher;
-                    meshComponent.pathHash = hasher(meshPath);
+                    meshComponent.mesh = exage::Renderer::internAsset(meshPath);
                     if (_meshSelectionCallback)
                     {
                         _meshSelectionCallback(meshPath);
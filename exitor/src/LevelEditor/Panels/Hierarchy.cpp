@@ -62,6 +62,16 @@ namespace exitor
                 }
             });
 
+        // setParent moves the RootEntity tag, which would reorder the view forEachRoot walks
+        if (_pendingReparent)
+        {
+            if (scene.isValid(_pendingReparent->entity) && scene.isValid(_pendingReparent->parent))
+            {
+                scene.setParent(_pendingReparent->entity, _pendingReparent->parent);
+            }
+            _pendingReparent.reset();
+        }
+
         if (ImGui::BeginPopupContextWindow(
                 "Hierarchy Context Menu",
                 ImGuiPopupFlags_MouseButtonRight | ImGuiPopupFlags_NoOpenOverItems))
@@ -119,7 +129,8 @@ namespace exitor
 
             if (ImGui::MenuItem("Delete Entity"))
             {
-                scene.destroyEntity(entity);
+                // The roots are still being iterated; the level editor destroys it next frame
+                scene.queueDestroy(entity);
                 deleted = true;
             }
 
@@ -142,7 +153,7 @@ namespace exitor
 
                 if (droppedEntity != entity)
                 {
-                    scene.setParent(droppedEntity, entity);
+                    _pendingReparent = Reparent {droppedEntity, entity};
                 }
 
                 ImGui::EndDragDropTarget();
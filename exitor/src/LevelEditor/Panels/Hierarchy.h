@@ -1,5 +1,7 @@
 #pragma once
 
+#include <optional>
+
 #include "exage/Scene/Entity.h"
 #include "exage/Scene/Scene.h"
 #include "exage/utils/classes.h"
@@ -22,5 +24,13 @@ namespace exitor
         void drawEntity(exage::Scene& scene, exage::Entity ignored, exage::Entity entity) noexcept;
 
         exage::Entity _selectedEntity = entt::null;
+
+        // A drop onto another entity, applied once the roots are no longer being iterated
+        struct Reparent
+        {
+            exage::Entity entity;
+            exage::Entity parent;
+        };
+        std::optional<Reparent> _pendingReparent;
     };
 }  // namespace exitor
\ No newline at end of file
@@ -26,11 +26,21 @@ namespace exage
         struct DeserializationFailed
         {
         };
+
+        struct Cancelled
+        {
+        };
+
+        struct UnsupportedFormat
+        {
+        };
     }  // namespace Errors
 
     using Error = std::variant<Errors::FileNotFound,
                                Errors::FileFormat,
                                Errors::DirectoryMissing,
                                Errors::SerializationFailed,
-                               Errors::DeserializationFailed>;
+                               Errors::DeserializationFailed,
+                               Errors::Cancelled,
+                               Errors::UnsupportedFormat>;
 }  // namespace exage
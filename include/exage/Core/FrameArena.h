@@ -0,0 +1,96 @@
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "exage/Core/Core.h"
+
+namespace exage
+{
+    /* Bump allocator for transient memory: allocating moves a pointer, deallocating does nothing
+     * and reset releases everything at once. When a block runs out another one is chained on, and
+     * the next reset replaces them all with a single block of their combined size, so a steady
+     * workload settles on one block. Not thread-safe; FrameArena keeps one per thread.
+     *
+     * Nothing allocated from it is destroyed, so it only holds trivially destructible objects, or
+     * pmr containers that are themselves destroyed before the reset, e.g.
+     * std::pmr::vector<Entity> scratch {&arena}. */
+    class LinearArena final : public std::pmr::memory_resource
+    {
+      public:
+        static constexpr size_t DEFAULT_BLOCK_SIZE = size_t {64} * 1024;
+
+        explicit LinearArena(size_t blockSize = DEFAULT_BLOCK_SIZE) noexcept;
+        ~LinearArena() override = default;
+
+        EXAGE_DELETE_COPY(LinearArena);
+        EXAGE_DELETE_MOVE(LinearArena);
+
+        void reset() noexcept;
+
+        template<typename T, typename... Args>
+        [[nodiscard]] auto create(Args&&... args) -> T*
+        {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "Arena objects are released without being destroyed");
+            return ::new (allocate(sizeof(T), alignof(T))) T(std::forward<Args>(args)...);
+        }
+
+        template<typename T>
+        [[nodiscard]] auto copy(std::span<const T> values) -> std::span<T>
+        {
+            static_assert(std::is_trivially_destructible_v<T>,
+                          "Arena objects are released without being destroyed");
+            auto* data = static_cast<T*>(allocate(values.size_bytes(), alignof(T)));
+            std::uninitialized_copy(values.begin(), values.end(), data);
+            return {data, values.size()};
+        }
+
+        // Bytes handed out since the last reset, and reserved in total
+        [[nodiscard]] auto getUsed() const noexcept -> size_t { return _used + _offset; }
+        [[nodiscard]] auto getCapacity() const noexcept -> size_t;
+
+      private:
+        auto do_allocate(size_t bytes, size_t alignment) -> void* override;
+        void do_deallocate(void* /*pointer*/, size_t /*bytes*/, size_t /*alignment*/) override {}
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+
+        struct Block
+        {
+            std::unique_ptr<std::byte[]> data;  // NOLINT(*-avoid-c-arrays)
+            size_t size;
+        };
+
+        size_t _blockSize;
+        std::vector<Block> _blocks;
+        size_t _offset = 0;  // Into the last block
+        size_t _used = 0;  // By the blocks before it
+    };
+
+    /* One LinearArena per thread and frame in flight, for memory that only has to last until the
+     * renderer comes back around to the same frame, such as what command buffers record. The
+     * graphics queue calls startFrame from Queue::startNextFrame, once the GPU is done with that
+     * frame's previous use; that resets the frame's arena on every thread.
+     *
+     * A thread must not hold on to get() across frames, as its arena may be reset under it once
+     * the queue wraps around. */
+    class FrameArena
+    {
+      public:
+        // The calling thread's arena for the current frame
+        [[nodiscard]] static auto get() noexcept -> LinearArena&;
+
+        [[nodiscard]] static auto getCurrentFrame() noexcept -> uint32_t;
+        static void startFrame(uint32_t frame) noexcept;
+    };
+}  // namespace exage
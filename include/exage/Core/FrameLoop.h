@@ -0,0 +1,79 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+
+#include "exage/Core/Core.h"
+
+namespace exage
+{
+    /* Runs the simulation at a fixed rate, decoupled from the rate frames are rendered at. Each
+     * frame, nextFrame adds the time since the previous frame to an accumulator and returns how
+     * many whole steps to simulate; whatever is left over gives the interpolation factor between
+     * the last two simulated states, for the renderer. For example:
+     *
+     *     uint32_t const steps = frameLoop.nextFrame();
+     *     for (uint32_t i = 0; i < steps; i++)
+     *     {
+     *         simulate(frameLoop.getStepSeconds());
+     *     }
+     *     render(frameLoop.getInterpolation());
+     *
+     * Time is kept in integer nanoseconds, so the same frame times always give the same steps,
+     * see advance. When a frame takes longer than maxStepsPerFrame steps, the rest is dropped and
+     * the simulation falls behind wall time, instead of spending ever longer catching up. */
+    class FrameLoop
+    {
+      public:
+        using Clock = std::chrono::steady_clock;
+        using Duration = std::chrono::nanoseconds;
+
+        static constexpr Duration DEFAULT_STEP = Duration {1'000'000'000 / 60};
+
+        explicit FrameLoop(Duration step = DEFAULT_STEP, uint32_t maxStepsPerFrame = 4) noexcept;
+
+        // Starts measuring from now, with nothing accumulated
+        void reset() noexcept;
+
+        // Measures the time since the previous frame; returns the steps to simulate this frame
+        [[nodiscard]] auto nextFrame() noexcept -> uint32_t;
+
+        // Like nextFrame, with a frame time from elsewhere, e.g. when replaying a recording
+        [[nodiscard]] auto advance(Duration frameTime) noexcept -> uint32_t;
+
+        [[nodiscard]] auto getStep() const noexcept -> Duration { return _step; }
+        [[nodiscard]] auto getStepSeconds() const noexcept -> float
+        {
+            return std::chrono::duration<float>(_step).count();
+        }
+
+        // Variable, for what does not go through the simulation, e.g. the GUI
+        [[nodiscard]] auto getFrameSeconds() const noexcept -> float
+        {
+            return std::chrono::duration<float>(_frameTime).count();
+        }
+
+        // In [0, 1): how far the present is from the last simulated state towards the next one
+        [[nodiscard]] auto getInterpolation() const noexcept -> float
+        {
+            return static_cast<float>(_accumulator.count()) / static_cast<float>(_step.count());
+        }
+
+        // Steps since reset, so the simulated time is getStepCount() * getStep()
+        [[nodiscard]] auto getStepCount() const noexcept -> uint64_t { return _stepCount; }
+
+        // Time given up to the catch-up limit since reset
+        [[nodiscard]] auto getDroppedTime() const noexcept -> Duration { return _droppedTime; }
+
+      private:
+        Duration _step;
+        uint32_t _maxStepsPerFrame;
+
+        Clock::time_point _lastFrame;
+        Duration _frameTime {0};
+        Duration _accumulator {0};
+
+        uint64_t _stepCount = 0;
+        Duration _droppedTime {0};
+    };
+}  // namespace exage
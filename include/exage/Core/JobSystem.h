@@ -0,0 +1,258 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "exage/Core/Core.h"
+
+namespace exage
+{
+    // Counts the outstanding jobs of one fork/join group
+    class JobCounter
+    {
+      public:
+        JobCounter() noexcept = default;
+        ~JobCounter() = default;
+
+        EXAGE_DELETE_COPY(JobCounter);
+        EXAGE_DELETE_MOVE(JobCounter);
+
+        [[nodiscard]] auto isDone() const noexcept -> bool
+        {
+            return _pending.load(std::memory_order_acquire) == 0;
+        }
+
+      private:
+        std::atomic<size_t> _pending {0};
+
+        friend class JobSystem;
+    };
+
+    /* A unit of work: invoke(data, begin, end). Whatever data points to must stay alive until the
+     * counter has been waited on. */
+    struct Job
+    {
+        void (*invoke)(void* data, size_t begin, size_t end) noexcept = nullptr;
+        void* data = nullptr;
+        size_t begin = 0;
+        size_t end = 0;
+        JobCounter* counter = nullptr;
+    };
+
+    /* Work-stealing scheduler. Each worker owns a deque that it pushes to and pops from at the
+     * back, idle workers steal from the front of the others, and threads outside the pool submit
+     * through a shared queue. Waiting on a counter runs pending jobs instead of blocking, so
+     * fork/join can nest freely. */
+    class JobSystem
+    {
+      public:
+        explicit JobSystem(size_t workerCount = defaultWorkerCount()) noexcept;
+        ~JobSystem();
+
+        EXAGE_DELETE_COPY(JobSystem);
+        EXAGE_DELETE_MOVE(JobSystem);
+
+        // Shared instance, created on first use
+        [[nodiscard]] static auto getDefault() noexcept -> JobSystem&;
+
+        // One worker per hardware thread, leaving one for the thread that submits the work
+        [[nodiscard]] static auto defaultWorkerCount() noexcept -> size_t;
+
+        [[nodiscard]] auto getWorkerCount() const noexcept -> size_t { return _workers.size(); }
+
+        void submit(const Job& job) noexcept;
+        void submit(std::span<const Job> jobs) noexcept;
+        void wait(JobCounter& counter) noexcept;
+
+        // Calls func(begin, end) over [0, count) in chunks of at least grainSize, then waits
+        template<typename F>
+        void parallelFor(size_t count, size_t grainSize, F&& func) noexcept;
+
+        // Calls func(entity) for every entity of an EnTT view, or for every element of a range
+        // such as a std::vector, then waits
+        template<typename View, typename F>
+        void parallelForEach(const View& view, F&& func, size_t grainSize = 1024) noexcept;
+
+        // Runs every callable concurrently, then waits
+        template<typename... F>
+        void parallelInvoke(F&&... funcs) noexcept;
+
+      private:
+        struct Worker
+        {
+            std::mutex mutex;
+            std::deque<Job> jobs;
+            std::jthread thread;
+        };
+
+        void workerLoop(size_t index) noexcept;
+        auto tryPop(Job& job) noexcept -> bool;
+        static void execute(const Job& job) noexcept;
+        void wakeWorkers(size_t jobCount) noexcept;
+
+        template<typename F>
+        static auto makeJob(F& func, JobCounter& counter) noexcept -> Job
+        {
+            using Func = std::remove_reference_t<F>;
+
+            return Job {
+                .invoke = [](void* data, size_t, size_t) noexcept
+                { (*static_cast<Func*>(data))(); },
+                .data = const_cast<std::remove_cv_t<Func>*>(std::addressof(func)),
+                .begin = 0,
+                .end = 1,
+                .counter = &counter,
+            };
+        }
+
+        std::vector<std::unique_ptr<Worker>> _workers;
+
+        std::mutex _sharedMutex;
+        std::deque<Job> _sharedJobs;  // Submitted from threads outside the pool
+
+        std::atomic<size_t> _queuedJobs {0};
+        std::atomic<bool> _stopping {false};
+        std::mutex _sleepMutex;
+        std::condition_variable _wakeCondition;
+    };
+
+    /* Tasks with dependencies, such as the stages of a frame. run() submits every task once all
+     * of its dependencies have finished and returns when the whole graph has run. A graph can be
+     * run again every frame. */
+    class TaskGraph
+    {
+      public:
+        using TaskID = size_t;
+
+        TaskGraph() noexcept = default;
+        ~TaskGraph() = default;
+
+        EXAGE_DELETE_COPY(TaskGraph);
+        EXAGE_DEFAULT_MOVE(TaskGraph);
+
+        auto addTask(std::function<void()> task) noexcept -> TaskID;
+        void addDependency(TaskID before, TaskID after) noexcept;  // after waits for before
+
+        void run(JobSystem& jobSystem) noexcept;
+
+        [[nodiscard]] auto size() const noexcept -> size_t { return _tasks.size(); }
+
+      private:
+        struct Task
+        {
+            std::function<void()> function;
+            std::vector<TaskID> successors;
+            uint32_t dependencyCount = 0;
+        };
+
+        static void runTask(void* data, size_t index, size_t end) noexcept;
+        auto makeJob(TaskID task) noexcept -> Job;
+
+        std::vector<Task> _tasks;
+
+        // Only valid during run()
+        std::unique_ptr<std::atomic<uint32_t>[]> _remaining;  // NOLINT(*-avoid-c-arrays)
+        JobSystem* _jobSystem = nullptr;
+        JobCounter* _counter = nullptr;
+    };
+
+    template<typename F>
+    void JobSystem::parallelFor(size_t count, size_t grainSize, F&& func) noexcept
+    {
+        if (count == 0)
+        {
+            return;
+        }
+
+        // Cap the number of chunks so tiny grains do not flood the queues
+        size_t const maxChunks = (_workers.size() + 1) * 8;
+        grainSize = std::max({grainSize, size_t {1}, (count + maxChunks - 1) / maxChunks});
+
+        if (count <= grainSize || _workers.empty())
+        {
+            func(size_t {0}, count);
+            return;
+        }
+
+        using Func = std::remove_reference_t<F>;
+
+        JobCounter counter;
+        std::vector<Job> jobs;
+        jobs.reserve((count + grainSize - 1) / grainSize);
+
+        for (size_t begin = grainSize; begin < count; begin += grainSize)
+        {
+            jobs.push_back(Job {
+                .invoke = [](void* data, size_t first, size_t last) noexcept
+                { (*static_cast<Func*>(data))(first, last); },
+                .data = const_cast<std::remove_cv_t<Func>*>(std::addressof(func)),
+                .begin = begin,
+                .end = std::min(begin + grainSize, count),
+                .counter = &counter,
+            });
+        }
+
+        submit(jobs);
+        func(size_t {0}, grainSize);
+        wait(counter);
+    }
+
+    template<typename View, typename F>
+    void JobSystem::parallelForEach(const View& view, F&& func, size_t grainSize) noexcept
+    {
+        using Iterator = decltype(view.begin());
+        using Category = typename std::iterator_traits<Iterator>::iterator_category;
+
+        // Views over a single storage can be indexed directly, the others are gathered first
+        if constexpr (std::is_base_of_v<std::random_access_iterator_tag, Category>)
+        {
+            auto const begin = view.begin();
+            auto const count = static_cast<size_t>(std::distance(begin, view.end()));
+
+            parallelFor(count,
+                        grainSize,
+                        [&](size_t first, size_t last)
+                        {
+                            for (size_t i = first; i < last; i++)
+                            {
+                                func(*(begin + static_cast<std::ptrdiff_t>(i)));
+                            }
+                        });
+        }
+        else
+        {
+            std::vector<std::decay_t<decltype(*view.begin())>> entities(view.begin(), view.end());
+
+            parallelFor(entities.size(),
+                        grainSize,
+                        [&](size_t first, size_t last)
+                        {
+                            for (size_t i = first; i < last; i++)
+                            {
+                                func(entities[i]);
+                            }
+                        });
+        }
+    }
+
+    template<typename... F>
+    void JobSystem::parallelInvoke(F&&... funcs) noexcept
+    {
+        JobCounter counter;
+        std::array<Job, sizeof...(F)> jobs {makeJob(funcs, counter)...};
+
+        submit(jobs);
+        wait(counter);
+    }
+}  // namespace exage
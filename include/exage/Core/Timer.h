@@ -11,13 +11,13 @@ namespace exage
 
         void reset() noexcept
         {
-            _lastFrameTime = std::chrono::high_resolution_clock::now();
-            _currentFrameTime = std::chrono::high_resolution_clock::now();
+            _lastFrameTime = std::chrono::steady_clock::now();
+            _currentFrameTime = std::chrono::steady_clock::now();
         }
         [[nodiscard]] auto nextFrame() noexcept -> float
         {
             _lastFrameTime = _currentFrameTime;
-            _currentFrameTime = std::chrono::high_resolution_clock::now();
+            _currentFrameTime = std::chrono::steady_clock::now();
 
             return std::chrono::duration<float>(_currentFrameTime - _lastFrameTime).count();
         }
@@ -28,8 +28,8 @@ namespace exage
       private:
         static void init() noexcept;
 
-        std::chrono::time_point<std::chrono::high_resolution_clock> _lastFrameTime;
-        std::chrono::time_point<std::chrono::high_resolution_clock> _currentFrameTime;
+        std::chrono::time_point<std::chrono::steady_clock> _lastFrameTime;
+        std::chrono::time_point<std::chrono::steady_clock> _currentFrameTime;
 
         friend void init() noexcept;
     };
@@ -2,12 +2,15 @@
 
 #include <memory_resource>
 #include <optional>
+#include <span>
 #include <thread>
+#include <type_traits>
 #include <utility>
 
 #include "Commands.h"
 #include "Error.h"
 #include "exage/Core/Core.h"
+#include "exage/Core/FrameArena.h"
 #include "exage/Graphics/Context.h"
 
 namespace exage::Graphics
@@ -77,7 +80,7 @@ namespace exage::Graphics
                                   uint32_t layerCount) noexcept = 0;
 
         virtual void beginRendering(std::shared_ptr<FrameBuffer> frameBuffer,
-                                    std::vector<ClearColor> clearColors,
+                                    std::span<const ClearColor> clearColors,
                                     ClearDepthStencil clearDepth) noexcept = 0;
         virtual void endRendering() noexcept = 0;
 
@@ -125,7 +128,20 @@ namespace exage::Graphics
                                         uint32_t binding,
                                         Texture::Aspect aspect) noexcept = 0;
 
-        virtual void userDefined(std::function<void(CommandBuffer&)> commandFunction) noexcept = 0;
+        /* Records `function(commandBuffer)` to be called when the command buffer is ended. The
+         * function is copied into the recording thread's FrameArena instead of the heap, so it
+         * must be trivially destructible, e.g. a lambda capturing pointers and values. */
+        template<typename F>
+        void userDefined(F&& function) noexcept
+        {
+            using Function = std::decay_t<F>;
+
+            recordUserDefined(Commands::UserDefinedCommand {
+                .invoke = [](void* data, CommandBuffer& commandBuffer) noexcept
+                { (*static_cast<Function*>(data))(commandBuffer); },
+                .function = FrameArena::get().create<Function>(std::forward<F>(function)),
+            });
+        }
 
         template<typename T>
         void setPushConstant(const T& data) noexcept
@@ -134,5 +150,8 @@ namespace exage::Graphics
         }
 
         EXAGE_BASE_API(API, CommandBuffer);
+
+      protected:
+        virtual void recordUserDefined(Commands::UserDefinedCommand command) noexcept = 0;
     };
 }  // namespace exage::Graphics
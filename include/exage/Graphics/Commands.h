@@ -1,6 +1,6 @@
 ﻿#pragma once
 
-#include <functional>
+#include <span>
 #include <variant>
 
 #include <entt/core/any.hpp>
@@ -163,7 +163,7 @@ namespace exage::Graphics
         struct BeginRenderingCommand
         {
             std::shared_ptr<FrameBuffer> frameBuffer;
-            std::vector<ClearColor> clearColors;
+            std::span<const ClearColor> clearColors;  // In the recording thread's FrameArena
             ClearDepthStencil clearDepth;
         };
 
@@ -173,7 +173,8 @@ namespace exage::Graphics
 
         struct UserDefinedCommand
         {
-            std::function<void(CommandBuffer&)> commandFunction;
+            void (*invoke)(void* function, CommandBuffer& commandBuffer) noexcept;
+            void* function;  // In the recording thread's FrameArena
         };
 
         struct CopyBufferCommand
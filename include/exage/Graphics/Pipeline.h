@@ -16,6 +16,9 @@ namespace exage::Graphics
             eU32,
             eI8,
             eI32,
+            eF16,
+            eUnorm16,  // Read as floats in [0, 1]
+            eSnorm16,  // Read as floats in [-1, 1]
         };
 
         uint32_t offset;
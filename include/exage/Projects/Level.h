@@ -1,6 +1,8 @@
 #pragma once
 
 #include <filesystem>
+#include <memory>
+#include <memory_resource>
 #include <string>
 #include <unordered_map>
 
@@ -31,8 +33,12 @@ namespace exage::Projects
     struct Level
     {
         std::string path;
-        
-        Scene scene;
+
+        // Backs the scene's registry, so unloading the level releases it in one go. Declared
+        // before the scene so that it is destroyed after it.
+        std::unique_ptr<std::pmr::memory_resource> memory =
+            std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        Scene scene {memory.get()};
     };
 
     [[nodiscard]] auto loadLevel(const std::filesystem::path& path) noexcept
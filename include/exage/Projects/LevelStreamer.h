@@ -0,0 +1,116 @@
+#pragma once
+
+#include <chrono>
+#include <filesystem>
+#include <limits>
+#include <memory>
+#include <memory_resource>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "exage/Core/Core.h"
+#include "exage/Core/Errors.h"
+#include "exage/Core/JobSystem.h"
+#include "exage/Scene/Scene.h"
+
+namespace exage::Projects
+{
+    enum class StreamingState : uint8_t
+    {
+        eLoading,    // Being read and deserialized on a worker
+        eStaged,     // Waiting for commit to move it into the scene, possibly partway through
+        eLoaded,     // Entirely in the scene
+        eUnloading,  // Waiting for commit to destroy its entities
+        eFailed,     // See getError; unload releases it
+    };
+
+    /* Streams levels in and out of one live Scene, e.g. the chunks of an open world around the
+     * camera. Each level is read and deserialized on the JobSystem into a staging scene of its
+     * own, so nothing blocks the calling thread. commit then moves staged levels into the live
+     * scene and destroys unloading ones, a batch of entities at a time, until its time budget is
+     * spent; call it once per frame. Every batch leaves the scene consistent, so systems may run
+     * between commits and see part of a level.
+     *
+     * Each level is placed below a root entity of its own, with an identity Transform3D that can
+     * be moved to offset the level. Unloading destroys the whole subtree, including entities that
+     * were parented to it afterwards. Entities of an unloading level must not be modified.
+     *
+     * Only the components that level files store are moved over, see Serialization.h. The Scene
+     * must outlive the streamer, which waits for loads in flight on destruction and leaves the
+     * levels it committed in the scene. A LevelID must not be used after it has been unloaded. */
+    class LevelStreamer
+    {
+      public:
+        using LevelID = uint32_t;
+
+        explicit LevelStreamer(Scene& scene,
+                               JobSystem& jobSystem = JobSystem::getDefault()) noexcept;
+        ~LevelStreamer();
+
+        EXAGE_DELETE_COPY(LevelStreamer);
+        EXAGE_DELETE_MOVE(LevelStreamer);
+
+        auto load(std::filesystem::path path) noexcept -> LevelID;
+
+        // Also cancels loads, discarding the result once the worker is done with it
+        void unload(LevelID level) noexcept;
+
+        // Returns true when there is nothing left to commit, not counting loads in flight
+        auto commit(std::chrono::microseconds budget) noexcept -> bool;
+
+        [[nodiscard]] auto getState(LevelID level) const noexcept -> StreamingState;
+
+        // entt::null until the level starts being committed
+        [[nodiscard]] auto getRoot(LevelID level) const noexcept -> Entity;
+
+        [[nodiscard]] auto getError(LevelID level) const noexcept -> std::optional<Error>;
+
+      private:
+        static constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+        // Entities moved or destroyed between two checks of the budget
+        static constexpr size_t BATCH_SIZE = 64;
+
+        struct StreamedLevel
+        {
+            std::filesystem::path path;
+            StreamingState state = StreamingState::eLoading;
+            bool discard = false;  // Unloaded while loading
+
+            JobCounter loading;
+            std::optional<Error> error;
+
+            // Written by the worker, then only touched by commit. The resource backs the staging
+            // scene, so it is declared first to be destroyed last.
+            std::unique_ptr<std::pmr::memory_resource> memory;
+            std::optional<Scene> staging;
+            std::vector<Entity> order;  // Staged entities, parents before their children
+            std::vector<uint32_t> parents;  // Into order, or NO_PARENT for the level's roots
+
+            Entity root = entt::null;
+            std::vector<Entity> entities;  // Live counterpart of each committed entry of order
+        };
+
+        static void loadJob(void* data, size_t begin, size_t end) noexcept;
+
+        using Deadline = std::chrono::steady_clock::time_point;
+
+        // Both return false when the budget ran out before the level was done
+        auto commitStaged(StreamedLevel& level, Deadline deadline) noexcept -> bool;
+        auto commitUnload(StreamedLevel& level, Deadline deadline) noexcept -> bool;
+
+        // Each component type takes one insert per batch
+        void moveComponents(StreamedLevel& level,
+                            std::span<const Entity> staged,
+                            std::span<const Entity> live) noexcept;
+        void releaseStaging(StreamedLevel& level) noexcept;
+
+        [[nodiscard]] auto getLevel(LevelID level) const noexcept -> const StreamedLevel&;
+
+        Scene& _scene;
+        JobSystem& _jobSystem;
+
+        std::vector<std::unique_ptr<StreamedLevel>> _levels;  // By LevelID, nullptr when free
+    };
+}  // namespace exage::Projects
@@ -29,7 +29,8 @@ namespace exage::Projects
         -> std::pair<uint32_t, std::unordered_map<std::string, ComponentData>>;
 
     [[nodiscard]] auto loadScene(
-        uint32_t entityCount, const std::unordered_map<std::string, ComponentData>& componentData)
-        -> Scene;
+        uint32_t entityCount,
+        const std::unordered_map<std::string, ComponentData>& componentData,
+        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) -> Scene;
 
 }  // namespace exage::Projects
\ No newline at end of file
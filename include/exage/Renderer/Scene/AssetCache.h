@@ -1,15 +1,94 @@
 ﻿#pragma once
 
 #include <filesystem>
+#include <limits>
+#include <utility>
+#include <vector>
 
 #include "exage/Core/Core.h"
+#include "exage/Core/Debug.h"
 #include "exage/Filesystem/Directories.h"
+#include "exage/Renderer/Scene/AssetHandle.h"
 #include "exage/Renderer/Scene/Material.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
 #include "exage/utils/classes.h"
 
 namespace exage::Renderer
 {
+    /* Loaded assets of one type, looked up by handle through an array instead of a hash map.
+     * Assets are densely packed, so pointers to them are invalidated by add and erase. */
+    template<typename T>
+    class AssetTable
+    {
+      public:
+        void add(AssetHandle handle, T asset) noexcept
+        {
+            debugAssume(handle.isValid(), "Asset added without a handle");
+
+            if (handle.index >= _indices.size())
+            {
+                _indices.resize(handle.index + 1, NO_INDEX);
+            }
+
+            // Like the maps this replaces, an asset that is already loaded is kept
+            if (_indices[handle.index] == NO_INDEX)
+            {
+                _indices[handle.index] = static_cast<uint32_t>(_assets.size());
+                _handles.push_back(handle);
+                _assets.push_back(std::move(asset));
+            }
+        }
+
+        [[nodiscard]] auto find(AssetHandle handle) noexcept -> T*
+        {
+            if (!contains(handle))
+            {
+                return nullptr;
+            }
+            return &_assets[_indices[handle.index]];
+        }
+
+        [[nodiscard]] auto find(AssetHandle handle) const noexcept -> const T*
+        {
+            if (!contains(handle))
+            {
+                return nullptr;
+            }
+            return &_assets[_indices[handle.index]];
+        }
+
+        [[nodiscard]] auto contains(AssetHandle handle) const noexcept -> bool
+        {
+            return handle.index < _indices.size() && _indices[handle.index] != NO_INDEX;
+        }
+
+        // Moves the last asset into the gap
+        void erase(AssetHandle handle) noexcept
+        {
+            if (!contains(handle))
+            {
+                return;
+            }
+
+            uint32_t const index = _indices[handle.index];
+            _assets[index] = std::move(_assets.back());
+            _handles[index] = _handles.back();
+            _indices[_handles[index].index] = index;
+            _indices[handle.index] = NO_INDEX;
+
+            _assets.pop_back();
+            _handles.pop_back();
+        }
+
+      private:
+        static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+        std::vector<uint32_t> _indices;  // Position of each asset, by handle
+        std::vector<AssetHandle> _handles;
+        std::vector<T> _assets;
+    };
+
     class AssetCache
     {
       public:
@@ -19,81 +98,89 @@ namespace exage::Renderer
         EXAGE_DEFAULT_COPY(AssetCache);
         EXAGE_DEFAULT_MOVE(AssetCache);
 
-        void addTexture(GPUTexture texture) noexcept { _textures.emplace(texture.path, texture); }
-        void addMesh(GPUStaticMesh mesh) noexcept { _meshes.emplace(mesh.pathHash, mesh); }
-        void addMaterial(GPUMaterial material) noexcept
+        void addTexture(GPUTexture texture) noexcept
         {
-            _materials.emplace(material.path, material);
+            AssetHandle handle = texture.handle;
+            _textures.add(handle, std::move(texture));
         }
-
-        [[nodiscard]] auto getTexture(const std::string& path) noexcept -> GPUTexture&
+        void addMesh(GPUStaticMesh mesh) noexcept
         {
-            return _textures[path];
+            AssetHandle handle = mesh.handle;
+            _meshes.add(handle, std::move(mesh));
         }
-        [[nodiscard]] auto getMesh(const std::string& path) noexcept -> GPUStaticMesh&
+        void addMaterial(GPUMaterial material) noexcept
         {
-            size_t hash = _hasher(path);
-            return _meshes[hash];
+            AssetHandle handle = material.handle;
+            _materials.add(handle, std::move(material));
         }
-        [[nodiscard]] auto getMaterial(const std::string& path) noexcept -> GPUMaterial&
+        void addPrefab(Prefab prefab) noexcept
         {
-            return _materials[path];
+            AssetHandle handle = prefab.handle;
+            _prefabs.add(handle, std::move(prefab));
         }
 
-        [[nodiscard]] auto hasTexture(const std::string& path) const noexcept -> bool
+        // The asset must have been added
+        [[nodiscard]] auto getTexture(AssetHandle handle) noexcept -> GPUTexture&
         {
-            return _textures.contains(path);
+            return get(_textures, handle);
         }
-        [[nodiscard]] auto hasMesh(const std::string& path) const noexcept -> bool
+        [[nodiscard]] auto getMesh(AssetHandle handle) noexcept -> GPUStaticMesh&
         {
-            size_t hash = _hasher(path);
-            return _meshes.contains(hash);
+            return get(_meshes, handle);
         }
-        [[nodiscard]] auto hasMaterial(const std::string& path) const noexcept -> bool
+        [[nodiscard]] auto getMaterial(AssetHandle handle) noexcept -> GPUMaterial&
         {
-            return _materials.contains(path);
+            return get(_materials, handle);
         }
 
-        [[nodiscard]] auto getMesh(size_t hash) noexcept -> GPUStaticMesh& { return _meshes[hash]; }
-        [[nodiscard]] auto hasMesh(size_t hash) const noexcept -> bool
+        [[nodiscard]] auto hasTexture(AssetHandle handle) const noexcept -> bool
         {
-            return _meshes.contains(hash);
+            return _textures.contains(handle);
         }
-        [[nodiscard]] auto getMeshIfExists(size_t hash) noexcept -> GPUStaticMesh*
+        [[nodiscard]] auto hasMesh(AssetHandle handle) const noexcept -> bool
         {
-            auto it = _meshes.find(hash);
-            if (it != _meshes.end())
-            {
-                return &it->second;
-            }
-
-            return nullptr;
+            return _meshes.contains(handle);
         }
-
-        [[nodiscard]] auto getMeshIfExists(size_t hash) const noexcept -> const GPUStaticMesh*
+        [[nodiscard]] auto hasMaterial(AssetHandle handle) const noexcept -> bool
         {
-            auto it = _meshes.find(hash);
-            if (it != _meshes.end())
-            {
-                return &it->second;
-            }
-
-            return nullptr;
+            return _materials.contains(handle);
+        }
+        [[nodiscard]] auto hasPrefab(AssetHandle handle) const noexcept -> bool
+        {
+            return _prefabs.contains(handle);
         }
 
-        void clearTexture(const std::string& path) noexcept { _textures.erase(path); }
-        void clearMaterial(const std::string& path) noexcept { _materials.erase(path); }
-        void clearMesh(const std::string& path) noexcept
+        [[nodiscard]] auto getMeshIfExists(AssetHandle handle) noexcept -> GPUStaticMesh*
         {
-            size_t hash = _hasher(path);
-            _meshes.erase(hash);
+            return _meshes.find(handle);
+        }
+        [[nodiscard]] auto getMeshIfExists(AssetHandle handle) const noexcept
+            -> const GPUStaticMesh*
+        {
+            return _meshes.find(handle);
+        }
+        [[nodiscard]] auto getPrefabIfExists(AssetHandle handle) const noexcept -> const Prefab*
+        {
+            return _prefabs.find(handle);
         }
 
+        void clearTexture(AssetHandle handle) noexcept { _textures.erase(handle); }
+        void clearMaterial(AssetHandle handle) noexcept { _materials.erase(handle); }
+        void clearMesh(AssetHandle handle) noexcept { _meshes.erase(handle); }
+        void clearPrefab(AssetHandle handle) noexcept { _prefabs.erase(handle); }
+
       private:
-        std::unordered_map<std::string, GPUTexture> _textures;
-        std::unordered_map<size_t, GPUStaticMesh> _meshes;
-        std::unordered_map<std::string, GPUMaterial> _materials;
+        template<typename T>
+        [[nodiscard]] static auto get(AssetTable<T>& table, AssetHandle handle) noexcept -> T&
+        {
+            T* asset = table.find(handle);
+            debugAssume(asset != nullptr, "Asset is not in the cache");
+            return *asset;
+        }
 
-        std::hash<std::string> _hasher;
+        AssetTable<GPUTexture> _textures;
+        AssetTable<GPUStaticMesh> _meshes;
+        AssetTable<GPUMaterial> _materials;
+        AssetTable<Prefab> _prefabs;  // Shared by every PrefabInstance
     };
 }  // namespace exage::Renderer
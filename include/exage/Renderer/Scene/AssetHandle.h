@@ -0,0 +1,56 @@
+#pragma once
+
+#include <compare>
+#include <limits>
+#include <string>
+#include <string_view>
+
+#include <cereal/types/string.hpp>
+
+#include "exage/Core/Core.h"
+
+namespace exage::Renderer
+{
+    /* A 32-bit stand-in for an asset path, interned once for the whole process by internAsset.
+     * Components store these instead of paths, and the AssetCache indexes arrays with them.
+     * Handles are only meaningful within one run, so archives store the path instead. */
+    struct AssetHandle
+    {
+        static constexpr uint32_t NULL_INDEX = std::numeric_limits<uint32_t>::max();
+
+        uint32_t index = NULL_INDEX;
+
+        [[nodiscard]] auto isValid() const noexcept -> bool { return index != NULL_INDEX; }
+
+        auto operator<=>(const AssetHandle&) const noexcept = default;
+
+        template<class Archive>
+        void save(Archive& archive) const;
+
+        template<class Archive>
+        void load(Archive& archive);
+    };
+
+    // Returns the handle of `path`, interning it first if needed. Safe to call from any thread.
+    [[nodiscard]] auto internAsset(std::string_view path) noexcept -> AssetHandle;
+
+    // Returns a null handle if `path` was never interned
+    [[nodiscard]] auto findAsset(std::string_view path) noexcept -> AssetHandle;
+
+    // Empty for a null handle. The string lives as long as the process.
+    [[nodiscard]] auto getAssetPath(AssetHandle handle) noexcept -> const std::string&;
+
+    template<class Archive>
+    void AssetHandle::save(Archive& archive) const
+    {
+        archive(getAssetPath(*this));
+    }
+
+    template<class Archive>
+    void AssetHandle::load(Archive& archive)
+    {
+        std::string path;
+        archive(path);
+        *this = path.empty() ? AssetHandle {} : internAsset(path);
+    }
+}  // namespace exage::Renderer
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <limits>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Core/Debug.h"
+#include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Utils/Frustum.h"
+#include "exage/Scene/Entity.h"
+
+namespace exage::Renderer
+{
+    [[nodiscard]] inline auto getUnion(const AABB& lhs, const AABB& rhs) noexcept -> AABB
+    {
+        return {glm::min(lhs.min, rhs.min), glm::max(lhs.max, rhs.max)};
+    }
+
+    [[nodiscard]] inline auto overlaps(const AABB& lhs, const AABB& rhs) noexcept -> bool
+    {
+        return glm::all(glm::lessThanEqual(glm::vec3 {lhs.min}, glm::vec3 {rhs.max}))
+            && glm::all(glm::lessThanEqual(glm::vec3 {rhs.min}, glm::vec3 {lhs.max}));
+    }
+
+    [[nodiscard]] inline auto encloses(const AABB& outer, const AABB& inner) noexcept -> bool
+    {
+        return glm::all(glm::lessThanEqual(glm::vec3 {outer.min}, glm::vec3 {inner.min}))
+            && glm::all(glm::lessThanEqual(glm::vec3 {inner.max}, glm::vec3 {outer.max}));
+    }
+
+    // Half the surface area, which is all the insertion cost needs
+    [[nodiscard]] inline auto getHalfArea(const AABB& aabb) noexcept -> float
+    {
+        glm::vec3 size = glm::vec3 {aabb.max - aabb.min};
+        return size.x * size.y + size.y * size.z + size.z * size.x;
+    }
+
+    // Bounds of a transformed box, from the absolute matrix instead of its eight corners
+    [[nodiscard]] inline auto transformAABB(const AABB& aabb, const glm::mat4& matrix) noexcept
+        -> AABB
+    {
+        glm::vec3 center = glm::vec3 {aabb.max + aabb.min} * 0.5F;
+        glm::vec3 extent = glm::vec3 {aabb.max - aabb.min} * 0.5F;
+
+        glm::mat3 absolute {glm::abs(glm::vec3 {matrix[0]}),
+                            glm::abs(glm::vec3 {matrix[1]}),
+                            glm::abs(glm::vec3 {matrix[2]})};
+
+        glm::vec3 worldCenter = glm::vec3 {matrix * glm::vec4 {center, 1.F}};
+        glm::vec3 worldExtent = absolute * extent;
+        return {glm::vec4 {worldCenter - worldExtent, 0.F},
+                glm::vec4 {worldCenter + worldExtent, 0.F}};
+    }
+
+    /* Dynamic AABB tree over entities, balanced with tree rotations as leaves come and go. Leaves
+     * store their bounds enlarged by a margin, so an entity that moves a little does not change
+     * the tree at all. Queries visit O(log n) nodes plus the ones they report. */
+    class BoundingVolumeHierarchy
+    {
+      public:
+        // Fraction of a leaf's size added on every side
+        static constexpr float FAT_MARGIN = 0.1F;
+
+        BoundingVolumeHierarchy() noexcept = default;
+        ~BoundingVolumeHierarchy() = default;
+
+        EXAGE_DEFAULT_COPY(BoundingVolumeHierarchy);
+        EXAGE_DEFAULT_MOVE(BoundingVolumeHierarchy);
+
+        // Inserts the entity, or moves it if it is already in the tree
+        void update(Entity entity, const AABB& bounds) noexcept;
+        void remove(Entity entity) noexcept;
+        void clear() noexcept;
+
+        [[nodiscard]] auto contains(Entity entity) const noexcept -> bool
+        {
+            return findLeaf(entity) != NULL_NODE;
+        }
+
+        [[nodiscard]] auto size() const noexcept -> size_t { return _leafCount; }
+        [[nodiscard]] auto empty() const noexcept -> bool { return _leafCount == 0; }
+        [[nodiscard]] auto getHeight() const noexcept -> uint32_t
+        {
+            return _root == NULL_NODE ? 0 : _nodes[_root].height;
+        }
+
+        // The enlarged bounds stored for the entity
+        [[nodiscard]] auto getFatBounds(Entity entity) const noexcept -> const AABB&
+        {
+            uint32_t const leaf = findLeaf(entity);
+            debugAssume(leaf != NULL_NODE, "Entity is not in the hierarchy");
+            return _nodes[leaf].bounds;
+        }
+
+        // Calls func(entity) for every entity whose fat bounds overlap `bounds`
+        template<typename F>
+        void queryOverlap(const AABB& bounds, F&& func) const noexcept
+        {
+            traverse([&](const AABB& node) { return overlaps(node, bounds); },
+                     [&](const Node& leaf) { func(leaf.entity); });
+        }
+
+        // Calls func(entity) for every entity whose fat bounds intersect the frustum
+        template<typename F>
+        void queryFrustum(const Frustum& frustum, F&& func) const noexcept
+        {
+            traverse([&](const AABB& node) { return frustum.intersects(node); },
+                     [&](const Node& leaf) { func(leaf.entity); });
+        }
+
+        /* Calls func(entity, entryDistance) for every entity whose fat bounds the ray enters within
+         * maxDistance. func returns the new maxDistance, so a closest-hit search can return the
+         * distance of its best hit so far and skip everything behind it. */
+        template<typename F>
+        void queryRay(glm::vec3 origin, glm::vec3 direction, float maxDistance, F&& func) const
+            noexcept;
+
+      private:
+        static constexpr uint32_t NULL_NODE = std::numeric_limits<uint32_t>::max();
+        static constexpr size_t MAX_QUERY_DEPTH = 128;  // Far beyond any balanced tree's height
+
+        struct Node
+        {
+            AABB bounds;
+            Entity entity = entt::null;  // Only set on leaves
+            uint32_t parent = NULL_NODE;  // Next free node while on the free list
+            std::array<uint32_t, 2> children {NULL_NODE, NULL_NODE};
+            uint32_t height = 0;  // 0 for leaves
+
+            [[nodiscard]] auto isLeaf() const noexcept -> bool { return children[0] == NULL_NODE; }
+        };
+
+        [[nodiscard]] auto findLeaf(Entity entity) const noexcept -> uint32_t
+        {
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= _leaves.size() || _leaves[id] == NULL_NODE
+                || _nodes[_leaves[id]].entity != entity)
+            {
+                return NULL_NODE;
+            }
+            return _leaves[id];
+        }
+
+        auto allocateNode() noexcept -> uint32_t;
+        void freeNode(uint32_t node) noexcept;
+
+        void insertLeaf(uint32_t leaf) noexcept;
+        void removeLeaf(uint32_t leaf) noexcept;
+        void refitAncestors(uint32_t node) noexcept;
+        auto rotate(uint32_t node) noexcept -> uint32_t;
+
+        // Depth-first walk into every node for which test(bounds) holds, calling visit(leaf)
+        template<typename Test, typename Visit>
+        void traverse(Test&& test, Visit&& visit) const noexcept
+        {
+            if (_root == NULL_NODE)
+            {
+                return;
+            }
+
+            std::array<uint32_t, MAX_QUERY_DEPTH> stack;  // NOLINT(*-member-init)
+            size_t count = 0;
+            stack[count++] = _root;
+
+            while (count > 0)
+            {
+                const Node& node = _nodes[stack[--count]];
+                if (!test(node.bounds))
+                {
+                    continue;
+                }
+
+                if (node.isLeaf())
+                {
+                    visit(node);
+                    continue;
+                }
+
+                debugAssume(count + 2 <= stack.size(), "Bounding volume hierarchy too deep");
+                stack[count++] = node.children[0];
+                stack[count++] = node.children[1];
+            }
+        }
+
+        std::vector<Node> _nodes;
+        uint32_t _root = NULL_NODE;
+        uint32_t _freeList = NULL_NODE;
+        size_t _leafCount = 0;
+
+        std::vector<uint32_t> _leaves;  // Leaf of each entity, by entity identifier
+    };
+
+    template<typename F>
+    void BoundingVolumeHierarchy::queryRay(glm::vec3 origin,
+                                           glm::vec3 direction,
+                                           float maxDistance,
+                                           F&& func) const noexcept
+    {
+        // Slab test; infinities from zero components compare correctly on their own
+        glm::vec3 const inverseDirection = 1.F / direction;
+
+        auto entryDistance = [&](const AABB& bounds) -> float
+        {
+            glm::vec3 const t1 = (glm::vec3 {bounds.min} - origin) * inverseDirection;
+            glm::vec3 const t2 = (glm::vec3 {bounds.max} - origin) * inverseDirection;
+            glm::vec3 const entries = glm::min(t1, t2);
+            glm::vec3 const exits = glm::max(t1, t2);
+
+            float const entry = std::max({entries.x, entries.y, entries.z, 0.F});
+            float const exit = std::min({exits.x, exits.y, exits.z, maxDistance});
+            return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+        };
+
+        traverse([&](const AABB& bounds) { return entryDistance(bounds) <= maxDistance; },
+                 [&](const Node& leaf)
+                 { maxDistance = func(leaf.entity, entryDistance(leaf.bounds)); });
+    }
+}  // namespace exage::Renderer
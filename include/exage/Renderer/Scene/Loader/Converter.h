@@ -1,8 +1,10 @@
 ﻿#pragma once
 
+#include <atomic>
 #include <filesystem>
 #include <memory>
 #include <optional>
+#include <span>
 #include <vector>
 
 #include "exage/Core/Core.h"
@@ -10,14 +12,57 @@
 #include "exage/Graphics/CommandBuffer.h"
 #include "exage/Renderer/Scene/AssetCache.h"
 #include "exage/Renderer/Scene/Loader/AssetFile.h"
+#include "exage/Renderer/Scene/Loader/MipGeneration.h"
+#include "exage/Renderer/Scene/Loader/TextureCompression.h"
 #include "exage/Renderer/Scene/Material.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
 #include "exage/Scene/Hierarchy.h"
 #include "exage/Scene/Scene.h"
 #include "tl/expected.hpp"
 
 namespace exage::Renderer
 {
+    /* Shared between an import running on the job system and the threads watching it. The import
+     * adds the steps it finds to do and counts off the ones it finishes; any thread may cancel
+     * it, after which no further steps start and the import fails with Errors::Cancelled. Steps
+     * already running still finish. */
+    class ImportProgress
+    {
+      public:
+        ImportProgress() noexcept = default;
+        ~ImportProgress() = default;
+
+        EXAGE_DELETE_COPY(ImportProgress);
+        EXAGE_DELETE_MOVE(ImportProgress);
+
+        void cancel() noexcept { _cancelled.store(true, std::memory_order_relaxed); }
+
+        [[nodiscard]] auto isCancelled() const noexcept -> bool
+        {
+            return _cancelled.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] auto getCompletedSteps() const noexcept -> size_t
+        {
+            return _completed.load(std::memory_order_relaxed);
+        }
+
+        // Grows while an import is still finding work, e.g. once Assimp has read a file
+        [[nodiscard]] auto getTotalSteps() const noexcept -> size_t
+        {
+            return _total.load(std::memory_order_relaxed);
+        }
+
+        void addSteps(size_t count) noexcept { _total.fetch_add(count, std::memory_order_relaxed); }
+        void completeStep() noexcept { _completed.fetch_add(1, std::memory_order_relaxed); }
+
+      private:
+        std::atomic<size_t> _completed {0};
+        std::atomic<size_t> _total {0};
+        std::atomic<bool> _cancelled {false};
+    };
+
     struct AssetImportResult2
     {
         std::vector<std::filesystem::path> textures;
@@ -93,16 +138,50 @@ namespace exage::Renderer
         std::vector<SpotLight> spotLights;
     };
 
-    [[nodiscard]] auto importAsset2(const std::filesystem::path& assetPath) noexcept
+    // Meshes are converted in parallel, one step each
+    [[nodiscard]] auto importAsset2(const std::filesystem::path& assetPath,
+                                    ImportProgress* progress = nullptr) noexcept
         -> tl::expected<AssetImportResult2, Error>;
 
-    [[nodiscard]] auto importTexture(const std::filesystem::path& texturePath) noexcept
+    // With a full mip chain unless mipOptions.maxLevels is 1, see generateMips
+    [[nodiscard]] auto importTexture(const std::filesystem::path& texturePath,
+                                     const MipGenerationOptions& mipOptions = {}) noexcept
         -> tl::expected<Texture, Error>;
 
     void optimizePrecision(Texture& texture) noexcept;
 
+    struct TextureImport
+    {
+        std::filesystem::path sourcePath;
+        std::filesystem::path savePath;
+        std::string path;  // Stored as Texture::path
+
+        MipGenerationOptions mips;
+
+        // Only applies to 8-bit textures; nullopt keeps the texels as they are
+        std::optional<BlockCompressionOptions> compression = BlockCompressionOptions {};
+    };
+
+    /* One TextureImport for each of the asset's textures, saved to saveDirectory under their own
+     * file names. Albedo and emissive textures are filtered as sRGB color, normal maps are
+     * renormalized, and data textures compressed without perceptual weighting. */
+    [[nodiscard]] auto makeTextureImports(const AssetImportResult2& asset,
+                                          const std::filesystem::path& saveDirectory) noexcept
+        -> std::vector<TextureImport>;
+
+    /* Decodes, generates mips for, block-compresses and saves every texture, in that order, as
+     * four steps each. Textures are processed concurrently on the default job system, and the
+     * filtering and encoding within each one is split up further, so a large batch keeps every
+     * core busy. Returns the outcome of each texture, in order; one failing does not stop the
+     * others. */
+    [[nodiscard]] auto importTextures(std::span<const TextureImport> textures,
+                                      ImportProgress* progress = nullptr) noexcept
+        -> std::vector<tl::expected<void, Error>>;
+
     [[nodiscard]] auto saveTexture(Texture& texture) noexcept -> AssetFile;
     [[nodiscard]] auto saveMaterial(Material& material) noexcept -> AssetFile;
+
+    // Vertices are stored in mesh.vertexFormat, so call packVertices first for a compact file
     [[nodiscard]] auto saveMesh(StaticMesh& mesh) noexcept -> AssetFile;
 
     [[nodiscard]] auto saveTexture(Texture& texture, const std::filesystem::path& savePath) noexcept
@@ -112,6 +191,10 @@ namespace exage::Renderer
         -> tl::expected<void, Error>;
     [[nodiscard]] auto saveMesh(StaticMesh& mesh, const std::filesystem::path& savePath) noexcept
         -> tl::expected<void, Error>;
+    [[nodiscard]] auto savePrefab(const Prefab& prefab) noexcept -> AssetFile;
+    [[nodiscard]] auto savePrefab(const Prefab& prefab,
+                                  const std::filesystem::path& savePath) noexcept
+        -> tl::expected<void, Error>;
 
     struct AssetSceneImportInfo
     {
@@ -129,4 +212,14 @@ namespace exage::Renderer
                      Scene& scene,
                      Entity parent = entt::null) noexcept;
 
+    /* For models placed many times: the nodes become one shared Prefab, and every placement a
+     * single entity with a PrefabInstance, instead of an entity per node as with importScene */
+    [[nodiscard]] auto makePrefab(const AssetSceneImportInfo& info, std::string path) noexcept
+        -> Prefab;
+
+    auto placePrefab(const Prefab& prefab,
+                     Scene& scene,
+                     const Transform3D& transform = {},
+                     Entity parent = entt::null) noexcept -> Entity;
+
 }  // namespace exage::Renderer
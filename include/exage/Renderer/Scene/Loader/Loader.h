@@ -11,6 +11,7 @@
 #include "exage/Renderer/Scene/AssetCache.h"
 #include "exage/Renderer/Scene/Material.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
 #include "exage/Scene/Scene.h"
 
 namespace exage::Renderer
@@ -27,6 +28,9 @@ namespace exage::Renderer
     [[nodiscard]] auto loadMesh(const std::filesystem::path& path) noexcept
         -> tl::expected<StaticMesh, Error>;
 
+    [[nodiscard]] auto loadPrefab(const std::filesystem::path& path) noexcept
+        -> tl::expected<Prefab, Error>;
+
     struct TextureUploadOptions
     {
         Graphics::Context& context;
@@ -38,9 +42,8 @@ namespace exage::Renderer
         Graphics::Access access = Graphics::AccessFlags::eShaderRead;
         Graphics::PipelineStage pipelineStage = Graphics::PipelineStageFlags::eFragmentShader;
 
-        bool useCompressedFormat = true;
+        // From queryCompressedTextureSupport; if nullptr, the device is asked about each texture
         std::unordered_set<Graphics::Format>* supportedCompressedFormats = nullptr;
-        // If supportedCompressedFormats is nullptr, the function will query the supported formats
     };
 
     //    struct MeshUploadOptions
@@ -52,8 +55,10 @@ namespace exage::Renderer
     //        Graphics::PipelineStage pipelineStage = Graphics::PipelineStageFlags::eFragmentShader;
     //    };
 
+    // Fails with Errors::UnsupportedFormat if the device cannot sample the texture's block format
     [[nodiscard]] auto uploadTexture(const Texture& texture,
-                                     const TextureUploadOptions& options) noexcept -> GPUTexture;
+                                     const TextureUploadOptions& options) noexcept
+        -> tl::expected<GPUTexture, Error>;
 
     //    [[nodiscard]] auto uploadMesh(const StaticMesh& mesh, const MeshUploadOptions& options)
     //    noexcept
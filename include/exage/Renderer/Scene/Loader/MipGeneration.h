@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+
+#include <tl/expected.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Core/Errors.h"
+#include "exage/Renderer/Scene/Material.h"
+
+namespace exage::Renderer
+{
+    enum class MipFilter : uint8_t
+    {
+        eBox,  // Plain average; fastest, but softest and prone to aliasing
+        eKaiser,  // Kaiser-windowed sinc, three texels wide; sharp with little ringing
+        eLanczos,  // Three-lobed Lanczos; sharpest, rings slightly around hard edges
+    };
+
+    struct MipGenerationOptions
+    {
+        MipFilter filter = MipFilter::eKaiser;
+
+        /* The first three channels of an 8-bit texture hold sRGB-encoded color, such as albedo,
+         * and are filtered in linear space. Alpha is always filtered as is. */
+        bool srgb = false;
+
+        /* The first channels hold a tangent-space normal, mapped from [-1, 1]. Every level is
+         * renormalized; with only two channels, x and y are kept within the unit circle. */
+        bool normalMap = false;
+
+        uint32_t maxLevels = 0;  // Including the first; 0 for a full chain down to 1x1
+    };
+
+    /* Replaces every mip after the first with a chain downsampled from it, each level halving the
+     * extent, rounded down, like the Vulkan mip sizes. Each level is filtered from the previous one
+     * in full float precision, and the rows of a level in parallel on the default job system. Fails
+     * for block-compressed and 3D textures; generate mips before compressTexture. */
+    [[nodiscard]] auto generateMips(Texture& texture,
+                                    const MipGenerationOptions& options = {}) noexcept
+        -> tl::expected<void, Error>;
+}  // namespace exage::Renderer
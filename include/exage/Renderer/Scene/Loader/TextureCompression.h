@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+
+#include <tl/expected.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Core/Errors.h"
+#include "exage/Graphics/Texture.h"
+#include "exage/Renderer/Scene/Material.h"
+
+namespace exage::Renderer
+{
+    enum class BlockCompressionQuality : uint8_t
+    {
+        eFast,
+        eNormal,
+        eHigh,
+    };
+
+    struct BlockCompressionOptions
+    {
+        // By default BC4 for one channel, BC5 for two and BC7 for four
+        std::optional<Graphics::Format> format = std::nullopt;
+        BlockCompressionQuality quality = BlockCompressionQuality::eNormal;
+
+        // Weighs color error by perceived brightness; off for data such as normal maps
+        bool perceptual = true;
+
+        /* Rate-distortion optimization, for BC1, BC3, BC4 and BC5: each 8 byte part of a block,
+         * all of a BC1 or BC4 one, is replaced by a copy of the same part of an earlier block when
+         * that adds at most this much mean squared error per texel and channel. Repeated bytes
+         * are what zstd compresses well in .extex files. 0 disables it. */
+        float rdoTolerance = 0.F;
+        uint32_t rdoWindow = 16;  // Earlier blocks in the same row considered
+    };
+
+    [[nodiscard]] auto isBlockCompressed(Graphics::Format format) noexcept -> bool;
+
+    // Bytes per 4x4 block, for the BC formats
+    [[nodiscard]] auto getBlockSize(Graphics::Format format) noexcept -> size_t;
+
+    /* Encodes every mip of an 8-bit texture to 4x4 blocks in place, setting compressedFormat. Mips
+     * whose extent is not a multiple of 4 are padded by repeating their edge texels. Blocks are
+     * encoded in parallel on the default job system. */
+    [[nodiscard]] auto compressTexture(Texture& texture,
+                                       const BlockCompressionOptions& options = {}) noexcept
+        -> tl::expected<void, Error>;
+}  // namespace exage::Renderer
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <filesystem>
+#include <optional>
 #include <vector>
 
 #include <glm/fwd.hpp>
@@ -9,6 +10,7 @@
 
 #include "exage/Core/Core.h"
 #include "exage/Graphics/Texture.h"
+#include "exage/Renderer/Scene/AssetHandle.h"
 
 namespace exage::Renderer
 {
@@ -28,11 +30,15 @@ namespace exage::Renderer
         uint8_t bitsPerChannel;
         uint8_t layers;
         Graphics::Texture::Type type;
+
+        // Set once data holds 4x4 blocks of this format, see compressTexture
+        std::optional<Graphics::Format> compressedFormat = std::nullopt;
     };
 
     struct GPUTexture
     {
         std::string path;
+        AssetHandle handle;
 
         std::shared_ptr<Graphics::Texture> texture;
     };
@@ -90,6 +96,7 @@ namespace exage::Renderer
         };
 
         std::string path;
+        AssetHandle handle;
 
         GPUTexture albedoTexture;
         GPUTexture emissiveTexture;
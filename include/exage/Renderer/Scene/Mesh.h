@@ -1,11 +1,17 @@
 ﻿#pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
 #include <entt/core/hashed_string.hpp>
 #include <exage/utils/serialization.h>
 #include <glm/glm.hpp>
 
 #include "exage/Core/Core.h"
 #include "exage/Graphics/Buffer.h"
+#include "exage/Renderer/Scene/AssetHandle.h"
 #include "exage/Renderer/Scene/Material.h"
 
 namespace exage::Renderer
@@ -21,6 +27,33 @@ namespace exage::Renderer
         glm::vec4 bitangent {};
     };
 
+    enum class VertexFormat : uint8_t
+    {
+        eFull,  // StaticMeshVertex, 80 bytes
+        ePacked,  // PackedStaticMeshVertex, 24 bytes
+        eQuantized,  // QuantizedStaticMeshVertex, 20 bytes
+    };
+
+    /* Normal and tangent are octahedral-encoded snorm16 pairs, and the lowest bit of the tangent's
+     * second component is set when the bitangent is cross(normal, tangent) negated. UVs are half
+     * floats. See VertexPacking.h. */
+    struct PackedStaticMeshVertex
+    {
+        glm::vec3 position {};
+        std::array<int16_t, 2> normal {};
+        std::array<int16_t, 2> tangent {};
+        std::array<uint16_t, 2> uv {};
+    };
+
+    // Like PackedStaticMeshVertex, with the position as unorm16 within the mesh's AABB
+    struct QuantizedStaticMeshVertex
+    {
+        std::array<uint16_t, 4> position {};  // w is 65535, so it reads as 1
+        std::array<int16_t, 2> normal {};
+        std::array<int16_t, 2> tangent {};
+        std::array<uint16_t, 2> uv {};
+    };
+
     struct MeshDetails
     {
         uint32_t vertexCount;
@@ -45,7 +78,11 @@ namespace exage::Renderer
 
         std::string materialPath;
 
+        // With VertexFormat::eFull the vertices are in vertices, otherwise packedVertices holds
+        // them as the format's struct
+        VertexFormat vertexFormat = VertexFormat::eFull;
         std::vector<StaticMeshVertex> vertices;
+        std::vector<std::byte> packedVertices;
         std::vector<uint32_t> indices;
 
         AABB aabb;
@@ -54,7 +91,7 @@ namespace exage::Renderer
     struct GPUStaticMesh
     {
         std::string path;
-        size_t pathHash;
+        AssetHandle handle;
 
         uint32_t lodCount;
         std::array<MeshDetails, MAX_LOD_COUNT> lods;
@@ -67,13 +104,12 @@ namespace exage::Renderer
 
     struct StaticMeshComponent
     {
-        std::string path;
-        size_t pathHash;
+        AssetHandle mesh;
 
         template<class Archive>
         void serialize(Archive& archive)
         {
-            archive(path, pathHash);
+            archive(mesh);
         }
     };
 
@@ -0,0 +1,105 @@
+#pragma once
+
+#include <limits>
+#include <span>
+#include <string>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Renderer/Scene/AssetHandle.h"
+#include "exage/Renderer/Scene/Mesh.h"
+
+namespace exage::Renderer
+{
+    struct PrefabMesh
+    {
+        AssetHandle mesh;
+        AABB aabb;  // Of the mesh itself, so placements can be culled without the AssetCache
+    };
+
+    /* An immutable subtree of meshes, shared by every PrefabInstance that places it. Its nodes are
+     * not entities: each stores its matrix relative to the prefab's root, so a placement expands
+     * with one multiplication per node. */
+    struct Prefab
+    {
+        static constexpr uint32_t NO_PARENT = std::numeric_limits<uint32_t>::max();
+
+        std::string path;
+        AssetHandle handle;
+
+        struct Node
+        {
+            glm::mat4 matrix;  // Relative to the prefab's root
+            uint32_t parent = NO_PARENT;  // Parents come before their children
+            uint32_t mesh = 0;  // Into meshes
+        };
+
+        std::vector<PrefabMesh> meshes;  // Each distinct mesh once
+        std::vector<Node> nodes;
+
+        AABB aabb;  // Of every node, relative to the prefab's root
+    };
+
+    // Swaps the mesh of one node of a single placement
+    struct PrefabOverride
+    {
+        static constexpr uint32_t HIDDEN = std::numeric_limits<uint32_t>::max();
+
+        uint32_t node;
+        uint32_t mesh;  // Into Prefab::meshes, or HIDDEN to leave the node out
+
+        template<class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(node, mesh);
+        }
+    };
+
+    /* Places a Prefab at the entity's world transform. Overrides are sorted by node, and must be
+     * replaced or patched through the registry to be picked up. */
+    struct PrefabInstance
+    {
+        AssetHandle prefab;
+        std::vector<PrefabOverride> overrides;
+
+        template<class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(prefab, overrides);
+        }
+    };
+
+    // Calls func(model, mesh) with every visible node of one placement of the prefab
+    template<typename F>
+    void forEachPrefabMesh(const Prefab& prefab,
+                           std::span<const PrefabOverride> overrides,
+                           const glm::mat4& model,
+                           F&& func) noexcept
+    {
+        auto next = overrides.begin();
+
+        for (uint32_t node = 0; node < prefab.nodes.size(); node++)
+        {
+            uint32_t mesh = prefab.nodes[node].mesh;
+
+            if (next != overrides.end() && next->node == node)
+            {
+                mesh = next->mesh;
+                ++next;
+            }
+
+            if (mesh != PrefabOverride::HIDDEN)
+            {
+                func(model * prefab.nodes[node].matrix, prefab.meshes[mesh]);
+            }
+        }
+    }
+
+    // Relative to the prefab's root; without overrides this is what Prefab::aabb holds
+    [[nodiscard]] auto calculatePrefabBounds(
+        const Prefab& prefab, std::span<const PrefabOverride> overrides = {}) noexcept -> AABB;
+
+    constexpr std::string_view PREFAB_EXTENSION = ".exprefab";
+}  // namespace exage::Renderer
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <vector>
+
+#include "exage/Core/Core.h"
+#include "exage/Renderer/Scene/AssetCache.h"
+#include "exage/Renderer/Scene/BoundingVolumeHierarchy.h"
+#include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Scene/Scene.h"
+
+namespace exage::Renderer
+{
+    /* Keeps a BoundingVolumeHierarchy of every static mesh and prefab placement of a Scene, using
+     * GPUStaticMesh::aabb or the prefab's bounds in world space. Only entities whose transform,
+     * mesh or prefab changed are updated, picked up from Scene::takeTransformChanges and
+     * Scene::takeChanges; assets that are not in the AssetCache yet are retried on every update
+     * until they are.
+     *
+     * The Scene and AssetCache must outlive the index, and the Scene must not be moved. */
+    class SpatialIndex
+    {
+      public:
+        SpatialIndex(Scene& scene, const AssetCache& assetCache) noexcept;
+        ~SpatialIndex();
+
+        EXAGE_DELETE_COPY(SpatialIndex);
+        EXAGE_DELETE_MOVE(SpatialIndex);
+
+        // Call after Scene::updateHierarchy
+        void update() noexcept;
+
+        // Queries report fat bounds, so callers that need exact results test the candidates
+        [[nodiscard]] auto getHierarchy() const noexcept -> const BoundingVolumeHierarchy&
+        {
+            return _hierarchy;
+        }
+
+      private:
+        void takeChanges() noexcept;
+        void refresh(Entity entity) noexcept;
+        void refreshAll() noexcept;
+
+        Scene& _scene;
+        const AssetCache& _assetCache;
+
+        Scene::TransformListener _transformListener;
+        TransformChanges _transformChanges;
+
+        Scene::ChangeListener _meshListener;
+        Scene::ChangeListener _prefabListener;
+        Scene::ChangeListener _transformRemovalListener;
+        Scene::ChangeListener _worldRemovalListener;
+        ComponentChanges _componentChanges;
+
+        std::vector<Entity> _changes;
+        std::vector<Entity> _unresolved;  // Waiting for their mesh to be loaded
+        std::vector<Entity> _traversal;
+
+        BoundingVolumeHierarchy _hierarchy;
+    };
+}  // namespace exage::Renderer
@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include <glm/glm.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Graphics/Pipeline.h"
+#include "exage/Renderer/Scene/Mesh.h"
+
+namespace exage::Renderer
+{
+    [[nodiscard]] auto getVertexSize(VertexFormat format) noexcept -> size_t;
+
+    /* The vertex input of the mesh shaders, at locations 0 to 4: position, normal, uv, tangent
+     * and, for eFull only, bitangent. The packed formats read their normal and tangent as snorm16
+     * pairs to decode with decodeOctahedral in shaders/vertex_packing.shader. */
+    [[nodiscard]] auto getVertexDescription(VertexFormat format) noexcept
+        -> Graphics::VertexDescription;
+
+    /* eQuantized positions are read in [0, 1] across the AABB. Draws fold this into the matrices
+     * that transform positions, as model * getDequantizationTransform(mesh.aabb), but not into
+     * the normal matrix, which it would skew. */
+    [[nodiscard]] auto getDequantizationTransform(const AABB& aabb) noexcept -> glm::mat4;
+
+    // Of a unit vector, to within about 0.01 degrees; a zero vector decodes as +z
+    [[nodiscard]] auto encodeOctahedral(glm::vec3 direction) noexcept -> std::array<int16_t, 2>;
+    [[nodiscard]] auto decodeOctahedral(std::array<int16_t, 2> encoded) noexcept -> glm::vec3;
+
+    /* Converts mesh.vertices to the given format in packedVertices, or back, in place. Packing is
+     * lossy: directions come back within a small angle, UVs to half precision and quantized
+     * positions to 1/65535 of the AABB. */
+    void packVertices(StaticMesh& mesh, VertexFormat format) noexcept;
+    void unpackVertices(StaticMesh& mesh) noexcept;
+}  // namespace exage::Renderer
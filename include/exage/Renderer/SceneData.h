@@ -3,6 +3,7 @@
 #include "exage/Renderer/Scene/Camera.h"
 #include "exage/Renderer/Scene/Light.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/SceneExtractor.h"
 #include "exage/Scene/Scene.h"
 
 namespace exage::Renderer
@@ -35,24 +36,6 @@ namespace exage::Renderer
 
     struct SceneData
     {
-        entt::storage<Transform3D> currentTransforms;
-        entt::storage<Transform3D> previousTransforms;
-
-        entt::storage<Camera> currentCameras;
-        entt::storage<Camera> previousCameras;
-
-        entt::storage<StaticMeshComponent> currentStaticMeshes;
-        entt::storage<StaticMeshComponent> previousStaticMeshes;
-
-        entt::storage<PointLight> currentPointLights;
-        entt::storage<PointLight> previousPointLights;
-
-        entt::storage<SpotLight> currentSpotLights;
-        entt::storage<SpotLight> previousSpotLights;
-
-        entt::storage<DirectionalLight> currentDirectionalLights;
-        entt::storage<DirectionalLight> previousDirectionalLights;
-
         std::optional<Graphics::ResizableDynamicBuffer> transformBuffer;
         std::optional<Graphics::ResizableDynamicBuffer> cameraBuffer;
         std::optional<Graphics::ResizableDynamicBuffer> pointLightBuffer;
@@ -64,7 +47,8 @@ namespace exage::Renderer
         Camera camera;
     };
 
-    /* Process: at start of frame, current scene data is swapped to become previous.
-     * Then, current scene data is filled with new data. Next, scene renderer renders scene-specific
-     * data. Next, camera renderer renders data relevant to a specific camera. */
+    /* Process: after updating the hierarchy, the simulation thread extracts a RenderSnapshot with
+     * SceneExtractor. The render thread acquires the latest snapshot, uploads its instances into
+     * the buffers above, renders scene-specific data, then data relevant to a specific camera, and
+     * releases the snapshot. Meanwhile the simulation is free to move on to the next frame. */
 }  // namespace exage::Renderer
\ No newline at end of file
@@ -0,0 +1,222 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include "exage/Core/Core.h"
+#include "exage/Renderer/Scene/Camera.h"
+#include "exage/Renderer/Scene/Light.h"
+#include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Scene/Scene.h"
+
+namespace exage::Renderer
+{
+    struct MeshInstance
+    {
+        glm::mat4 model;
+        glm::mat4 previousModel;  // As of the previous extraction, see SceneExtractor
+        AssetHandle mesh;
+    };
+
+    // Expanded into its meshes with forEachPrefabMesh, using the Prefab from the AssetCache
+    struct PrefabPlacement
+    {
+        glm::mat4 model;
+        glm::mat4 previousModel;
+        AssetHandle prefab;
+        std::vector<PrefabOverride> overrides;
+    };
+
+    struct CameraInstance
+    {
+        glm::mat4 model;  // The view matrix is its inverse
+        glm::mat4 previousModel;
+        Camera camera;
+    };
+
+    struct PointLightInstance
+    {
+        glm::vec3 position;
+        PointLight light;
+    };
+
+    struct SpotLightInstance
+    {
+        glm::vec3 position;
+        glm::vec3 direction;
+        SpotLight light;
+    };
+
+    struct DirectionalLightInstance
+    {
+        glm::vec3 direction;
+        DirectionalLight light;
+    };
+
+    // Densely packed copies of one component type, with the entity each one came from
+    template<typename T>
+    struct PackedInstances
+    {
+        static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+        std::vector<Entity> entities;
+        std::vector<T> instances;
+        std::vector<uint32_t> indices;  // Position of each entity, by entity identifier
+
+        [[nodiscard]] auto size() const noexcept -> size_t { return instances.size(); }
+        [[nodiscard]] auto empty() const noexcept -> bool { return instances.empty(); }
+
+        [[nodiscard]] auto find(Entity entity) const noexcept -> const T*
+        {
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= indices.size() || indices[id] == NO_INDEX || entities[indices[id]] != entity)
+            {
+                return nullptr;
+            }
+            return &instances[indices[id]];
+        }
+
+        void set(Entity entity, const T& instance) noexcept
+        {
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= indices.size())
+            {
+                indices.resize(id + 1, NO_INDEX);
+            }
+
+            uint32_t& index = indices[id];
+            if (index == NO_INDEX)
+            {
+                index = static_cast<uint32_t>(instances.size());
+                entities.push_back(entity);
+                instances.push_back(instance);
+                return;
+            }
+
+            // Also takes over the place of a destroyed entity whose identifier was recycled
+            entities[index] = entity;
+            instances[index] = instance;
+        }
+
+        // Moves the last instance into the gap
+        void erase(Entity entity) noexcept
+        {
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= indices.size() || indices[id] == NO_INDEX || entities[indices[id]] != entity)
+            {
+                return;
+            }
+
+            uint32_t const index = indices[id];
+            entities[index] = entities.back();
+            instances[index] = std::move(instances.back());
+            indices[static_cast<size_t>(entt::to_entity(entities[index]))] = index;
+            indices[id] = NO_INDEX;
+
+            entities.pop_back();
+            instances.pop_back();
+        }
+
+        void clear() noexcept
+        {
+            entities.clear();
+            instances.clear();
+            indices.clear();
+        }
+    };
+
+    // Everything the renderer needs from a Scene for one frame
+    struct RenderSnapshot
+    {
+        uint64_t frame = 0;  // Incremented by every extraction
+
+        PackedInstances<MeshInstance> meshes;
+        PackedInstances<PrefabPlacement> prefabs;
+        PackedInstances<CameraInstance> cameras;
+        PackedInstances<PointLightInstance> pointLights;
+        PackedInstances<SpotLightInstance> spotLights;
+        PackedInstances<DirectionalLightInstance> directionalLights;
+    };
+
+    /* Copies the render-relevant state of a Scene into a ring of snapshots, so that frame N can be
+     * rendered on another thread while the simulation already works on frame N + 1. Only entities
+     * that changed since a snapshot was last written are copied into it; a snapshot that the
+     * renderer still holds is never written to.
+     *
+     * Changes are picked up from the transform changes of Scene::updateHierarchy and from the
+     * registry's construct, update and destroy signals of the render components. Components that
+     * are modified in place, without patch or replace, must be reported through markChanged.
+     *
+     * Meshes, prefabs and cameras also carry their model matrix as of the previous extraction. When
+     * the simulation runs at a fixed step, see FrameLoop, and extracts after its last step of each
+     * frame, the renderer can blend the two with interpolateTransform by the loop's interpolation
+     * factor. Teleports are blended like any other move.
+     *
+     * extract and markChanged belong to the thread that owns the Scene, acquire and release may
+     * be called from any thread. The Scene must outlive the extractor and must not be moved. */
+    class SceneExtractor
+    {
+      public:
+        // One being written, one being rendered and one ready for the renderer to pick up next
+        static constexpr size_t SNAPSHOT_COUNT = 3;
+
+        explicit SceneExtractor(Scene& scene) noexcept;
+        ~SceneExtractor();
+
+        EXAGE_DELETE_COPY(SceneExtractor);
+        EXAGE_DELETE_MOVE(SceneExtractor);
+
+        // Call after Scene::updateHierarchy; waits only if the renderer is SNAPSHOT_COUNT - 1
+        // extractions behind
+        void extract() noexcept;
+
+        void markChanged(Entity entity) noexcept { _changes.push_back(entity); }
+
+        // The most recent snapshot, or nullptr before the first extraction
+        [[nodiscard]] auto acquire() noexcept -> const RenderSnapshot*;
+        void release(const RenderSnapshot& snapshot) noexcept;
+
+      private:
+        static constexpr int32_t WRITING = -1;
+
+        struct Slot
+        {
+            RenderSnapshot snapshot;
+
+            std::atomic<int32_t> state {0};  // Reader count, or WRITING
+            bool stale = true;  // Rebuilt from scratch on its next write
+            std::vector<Entity> pending;  // Otherwise, what changed since its last write
+        };
+
+        template<typename... Components>
+        void connectSignals() noexcept;
+        template<typename... Components>
+        void disconnectSignals() noexcept;
+
+        void recordChange(Scene::Registry& registry, Entity entity) noexcept;
+        void collectTransformChanges() noexcept;
+
+        void refresh(RenderSnapshot& snapshot,
+                     const RenderSnapshot* previous,
+                     Entity entity) noexcept;
+        void refreshAll(RenderSnapshot& snapshot, const RenderSnapshot* previous) noexcept;
+
+        Scene& _scene;
+
+        std::array<Slot, SNAPSHOT_COUNT> _slots;
+        std::atomic<size_t> _latest {SNAPSHOT_COUNT};  // SNAPSHOT_COUNT until the first extraction
+        uint64_t _frame = 0;
+
+        std::vector<Entity> _changes;
+        std::vector<Entity> _previousChanges;  // Refreshed again, to settle their previous model
+        Scene::TransformListener _transformListener;
+        TransformChanges _transformChanges;
+        std::vector<Entity> _traversal;
+    };
+}  // namespace exage::Renderer
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "exage/Core/Core.h"
+#include "exage/Scene/Entity.h"
+
+namespace exage
+{
+    // Entities whose component of one type changed, see Scene::takeChanges. In no particular order.
+    struct ComponentChanges
+    {
+        std::vector<Entity> added;
+        std::vector<Entity> updated;  // Through patch, replace or emplace_or_replace
+        std::vector<Entity> removed;  // Including with their entity, so they may be invalid now
+
+        [[nodiscard]] auto empty() const noexcept -> bool
+        {
+            return added.empty() && updated.empty() && removed.empty();
+        }
+
+        void clear() noexcept
+        {
+            added.clear();
+            updated.clear();
+            removed.clear();
+        }
+    };
+
+    /* Records the construct, update and destroy signals of one component type, separately for each
+     * listener and coalesced per entity since that listener last took its changes: an entity that
+     * was added and then updated is only reported as added, one that was added and then removed is
+     * not reported at all, and one that was removed and then added again is reported as updated.
+     * Nothing is recorded while there are no listeners.
+     *
+     * Scene owns one per component type that has been listened to; use it through the Scene. */
+    class ChangeTracker
+    {
+      public:
+        using Listener = uint32_t;
+
+        ChangeTracker() noexcept = default;
+        ~ChangeTracker() = default;
+
+        // The registry's signals point at the tracker
+        EXAGE_DELETE_COPY(ChangeTracker);
+        EXAGE_DELETE_MOVE(ChangeTracker);
+
+        template<typename T, typename Registry>
+        void connect(Registry& registry) noexcept
+        {
+            registry.template on_construct<T>()
+                .template connect<&ChangeTracker::onConstruct<Registry>>(*this);
+            registry.template on_update<T>()
+                .template connect<&ChangeTracker::onUpdate<Registry>>(*this);
+            registry.template on_destroy<T>()
+                .template connect<&ChangeTracker::onDestroy<Registry>>(*this);
+        }
+
+        auto addListener() noexcept -> Listener;
+        void removeListener(Listener listener) noexcept;
+
+        // Swaps the changes recorded since the previous call into `changes`, recycling its storage
+        void take(Listener listener, ComponentChanges& changes) noexcept;
+
+      private:
+        enum class Change : uint8_t
+        {
+            eAdded,
+            eUpdated,
+            eRemoved,
+        };
+
+        void record(Entity entity, Change change) noexcept;
+
+        template<typename Registry>
+        void onConstruct(Registry& /*registry*/, Entity entity) noexcept
+        {
+            record(entity, Change::eAdded);
+        }
+
+        template<typename Registry>
+        void onUpdate(Registry& /*registry*/, Entity entity) noexcept
+        {
+            record(entity, Change::eUpdated);
+        }
+
+        template<typename Registry>
+        void onDestroy(Registry& /*registry*/, Entity entity) noexcept
+        {
+            record(entity, Change::eRemoved);
+        }
+
+        std::vector<std::optional<std::unordered_map<Entity, Change>>> _listeners;
+        uint32_t _listenerCount = 0;
+    };
+}  // namespace exage
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <iostream>
+#include <span>
 #include <variant>
 
 #include <entt/entt.hpp>
@@ -29,6 +30,14 @@ namespace exage
     {
     };  // This is just a tag
 
+    struct TransformDirty
+    {
+    };  // Tag for entities whose global transform data must be recomputed
+
+    struct PendingDestroy
+    {
+    };  // Tag for subtrees that Scene::destroyPending will destroy
+
     struct Transform3D
     {
         glm::vec3 position {0.F};
@@ -55,12 +64,118 @@ namespace exage
         glm::vec3 euler;
     };
 
-    inline auto calculateTransformMatrix(Transform3D transform) noexcept -> glm::mat4
+    /* Opt-in compact alternative to Transform3D. Only the local data lives here; the derived world
+     * matrix is kept in WorldTransform, a separate storage, so a hierarchy update touches 88 bytes
+     * per entity instead of the 240 of a Transform3D. Compact transforms may sit below Transform3D
+     * entities, but not the other way around. */
+    struct CompactTransform
+    {
+        glm::vec3 position {0.F};
+        glm::quat rotation {glm::identity<glm::quat>()};
+        glm::vec3 scale {1.F};
+
+        template<class Archive>
+        void serialize(Archive& archive)
+        {
+            archive(position, rotation, scale);
+        }
+    };
+
+    // Added and kept up to date by the scene for every CompactTransform
+    struct WorldTransform
+    {
+        glm::mat4x3 matrix {1.F};  // Affine, the implicit last row is (0, 0, 0, 1)
+
+        [[nodiscard]] auto getMatrix() const noexcept -> glm::mat4 { return glm::mat4 {matrix}; }
+        [[nodiscard]] auto getPosition() const noexcept -> glm::vec3 { return matrix[3]; }
+
+        [[nodiscard]] auto getScale() const noexcept -> glm::vec3
+        {
+            return {glm::length(matrix[0]), glm::length(matrix[1]), glm::length(matrix[2])};
+        }
+
+        // Only meaningful without shear, i.e. when scales along the hierarchy are uniform
+        [[nodiscard]] auto getRotation() const noexcept -> glm::quat
+        {
+            glm::vec3 scale = getScale();
+            return glm::quat_cast(
+                glm::mat3 {matrix[0] / scale.x, matrix[1] / scale.y, matrix[2] / scale.z});
+        }
+    };
+
+    /* Equivalent to translate(position) * toMat4(rotation) * scale(scale), written out directly
+     * instead of through three full matrix products. The results are equal up to signed zeros and
+     * rounding, since the products add zero terms and may be contracted differently; only callers
+     * of this function, such as both hierarchy update paths, agree bit for bit. */
+    inline auto composeTransformMatrix(glm::vec3 position,
+                                       glm::quat rotation,
+                                       glm::vec3 scale) noexcept -> glm::mat4
+    {
+        float const qxx = rotation.x * rotation.x;
+        float const qyy = rotation.y * rotation.y;
+        float const qzz = rotation.z * rotation.z;
+        float const qxz = rotation.x * rotation.z;
+        float const qxy = rotation.x * rotation.y;
+        float const qyz = rotation.y * rotation.z;
+        float const qwx = rotation.w * rotation.x;
+        float const qwy = rotation.w * rotation.y;
+        float const qwz = rotation.w * rotation.z;
+
+        glm::vec3 const right {1.F - 2.F * (qyy + qzz), 2.F * (qxy + qwz), 2.F * (qxz - qwy)};
+        glm::vec3 const up {2.F * (qxy - qwz), 1.F - 2.F * (qxx + qzz), 2.F * (qyz + qwx)};
+        glm::vec3 const forward {2.F * (qxz + qwy), 2.F * (qyz - qwx), 1.F - 2.F * (qxx + qyy)};
+
+        // The zero w components are not scaled, so a negative scale cannot turn them into -0
+        glm::mat4 matrix;
+        matrix[0] = glm::vec4(right * scale.x, 0.F);
+        matrix[1] = glm::vec4(up * scale.y, 0.F);
+        matrix[2] = glm::vec4(forward * scale.z, 0.F);
+        matrix[3] = glm::vec4(position, 1.F);
+        return matrix;
+    }
+
+    inline auto composeAffineTransform(const CompactTransform& transform) noexcept -> glm::mat4x3
     {
-        glm::mat4 scaleMatrix = glm::scale(transform.scale);
-        glm::mat4 rotationMatrix = transform.rotation.getRotationMatrix();
-        glm::mat4 translationMatrix = glm::translate(transform.position);
+        return glm::mat4x3 {
+            composeTransformMatrix(transform.position, transform.rotation, transform.scale)};
+    }
 
-        return translationMatrix * rotationMatrix * scaleMatrix;
+    // parent * child for affine matrices, skipping the constant last row
+    inline auto multiplyAffine(const glm::mat4x3& parent, const glm::mat4x3& child) noexcept
+        -> glm::mat4x3
+    {
+        glm::mat3 const linear {parent};
+        return glm::mat4x3 {
+            linear * child[0], linear * child[1], linear * child[2], linear * child[3] + parent[3]};
+    }
+
+    inline auto calculateTransformMatrix(const Transform3D& transform) noexcept -> glm::mat4
+    {
+        return composeTransformMatrix(
+            transform.position, transform.rotation.getQuaternion(), transform.scale);
     }
+
+    /* Batched composeTransformMatrix over parallel arrays, several transforms per instruction
+     * when built with AVX or SSE2. All spans must have the same size. */
+    void composeTransformMatrices(std::span<const glm::vec3> positions,
+                                  std::span<const glm::quat> rotations,
+                                  std::span<const glm::vec3> scales,
+                                  std::span<glm::mat4> matrices) noexcept;
+
+    // Batched calculateTransformMatrix, writing each Transform3D::matrix
+    void calculateTransformMatrices(std::span<Transform3D> transforms) noexcept;
+
+    /* Computes the local and global data of a transform that has no parent. */
+    void propagateRootTransform(Transform3D& transform) noexcept;
+
+    /* Computes the local and global data of a transform from its parent's global data. Both
+     * hierarchy update paths go through these out-of-line definitions, so they produce
+     * bit-identical results. */
+    void propagateChildTransform(const Transform3D& parent, Transform3D& child) noexcept;
+
+    /* Same as above, with the parent's global rotation already converted by getRotationMatrix3.
+     * Lets the matrix be computed once for a parent with many children. */
+    void propagateChildTransform(const Transform3D& parent,
+                                 const glm::mat3& parentRotation,
+                                 Transform3D& child) noexcept;
 }  // namespace exage
@@ -1,33 +1,179 @@
 ﻿#pragma once
+#include <limits>
+#include <memory>
 #include <memory_resource>
+#include <optional>
+#include <span>
+#include <unordered_map>
+#include <vector>
 
 #include <entt/entity/registry.hpp>
 
 #include "exage/Core/Core.h"
+#include "exage/Scene/ChangeTracker.h"
 #include "exage/Scene/Entity.h"
 #include "exage/Scene/Hierarchy.h"
 
 namespace exage
 {
+    enum class TransformPropagation : uint8_t
+    {
+        eRecursive,  // Depth-first walk over the EntityRelationship links
+        eFlattened,  // Breadth-first levels, each level split across worker threads
+    };
+
+    enum class HierarchyStorage : uint8_t
+    {
+        eLinked,      // Follow the EntityRelationship sibling links
+        eDepthFirst,  // Depth-first sorted arrays, rebuilt lazily after structural changes
+    };
+
+    // A prepared subtree that Scene::instantiate copies in with a handful of bulk operations
+    struct ScenePrefab
+    {
+        static constexpr size_t NO_PARENT = std::numeric_limits<size_t>::max();
+
+        std::vector<size_t> parents;  // Index of each node's parent, which must come before it
+        std::vector<Transform3D> transforms;  // Empty to leave the nodes without one
+
+        // If not empty, the existing entity each NO_PARENT node is attached to, in place of the
+        // parent given to instantiate, or entt::null for a root
+        std::vector<Entity> externalParents;
+    };
+
+    // World transforms recomputed by updateHierarchy, see Scene::takeTransformChanges
+    struct TransformChanges
+    {
+        bool all = false;  // A full pass ran, so any transform may have changed
+        std::vector<Entity> subtrees;  // Otherwise, the roots of the recomputed subtrees
+    };
+
+    /* Component storages, sparse sets and the entity list of the registry come from the memory
+     * resource given on construction, which must outlive the scene. A pool or arena per level
+     * lets unloading release all of them at once, see Projects::Level.
+     *
+     * Scenes can be moved into new ones but not assigned to, since the registry's containers would
+     * then stay on the memory resource of the scene that was assigned over. */
     class Scene
     {
       public:
-        using Registry = entt::registry;  // May swap for an allocator in the future
+        using Allocator = std::pmr::polymorphic_allocator<Entity>;
+        using Registry = entt::basic_registry<Entity, Allocator>;
+        using Storage = entt::basic_sparse_set<Entity, Allocator>;  // Any type-erased storage
+        using TransformListener = uint32_t;
+        using ChangeListener = ChangeTracker::Listener;
 
-        Scene() = default;
+        explicit Scene(
+            std::pmr::memory_resource* resource = std::pmr::get_default_resource()) noexcept;
         ~Scene() = default;
 
-        EXAGE_DELETE_COPY(Scene);
-        EXAGE_DEFAULT_MOVE(Scene);
+        EXAGE_DELETE_COPY_CONSTRUCT(Scene)
+        EXAGE_DEFAULT_MOVE_CONSTRUCT(Scene)
+        EXAGE_DELETE_ASSIGN(Scene);
 
         auto createEntity(Entity parent = entt::null) noexcept -> Entity;
         void destroyEntity(Entity entity) noexcept;
 
+        // Bulk variants; the returned entities are in creation order
+        auto createEntities(size_t count, Entity parent = entt::null) noexcept
+            -> std::vector<Entity>;
+        auto instantiate(const ScenePrefab& prefab, Entity parent = entt::null) noexcept
+            -> std::vector<Entity>;
+        void destroySubtrees(std::span<const Entity> entities) noexcept;
+
+        /* Deferred destruction, for systems that find what to remove while iterating the scene.
+         * queueDestroy only tags the entity, so views over other components stay valid, and the
+         * entity remains usable until destroyPending removes every queued subtree in one batch at
+         * a point where nothing iterates the scene, such as before updateHierarchy. */
+        void queueDestroy(Entity entity) noexcept
+        {
+            _registry.emplace_or_replace<PendingDestroy>(entity);
+        }
+        [[nodiscard]] auto isPendingDestroy(Entity entity) const noexcept -> bool
+        {
+            return _registry.all_of<PendingDestroy>(entity);
+        }
+
+        // Returns the number of entities destroyed, descendants included
+        auto destroyPending() noexcept -> size_t;
+
+        /* Only dirty transforms and their descendants are recomputed. Adding, replacing, patching
+         * or removing a Transform3D or CompactTransform, and reparenting, mark an entity dirty;
+         * writes through getComponent must go through updateTransform or markTransformDirty. */
         void updateHierarchy(bool calculateTransforms = true) noexcept;
 
+        void markTransformDirty(Entity entity) noexcept
+        {
+            _registry.emplace_or_replace<TransformDirty>(entity);
+        }
+        void markAllTransformsDirty() noexcept;
+
+        template<typename T = Transform3D, typename F>
+        void updateTransform(Entity entity, F&& func) noexcept
+        {
+            func(getComponent<T>(entity));
+            markTransformDirty(entity);
+        }
+
+        /* For systems that mirror world transforms elsewhere, such as render extraction. Every
+         * listener sees each change once; nothing is recorded while there are no listeners. */
+        auto addTransformListener() noexcept -> TransformListener;
+        void removeTransformListener(TransformListener listener) noexcept;
+
+        // Swaps the changes recorded since the previous call into `changes`, recycling its storage
+        void takeTransformChanges(TransformListener listener, TransformChanges& changes) noexcept;
+
+        /* For systems that keep derived data per component, such as picking or render extraction.
+         * Each listener sees which entities gained, updated or lost a T, without rescanning the
+         * views. Updates are only seen through the registry's patch and replace, which is what
+         * patchComponent uses; a component written through getComponent is not reported. */
+        template<typename T>
+        auto addChangeListener() noexcept -> ChangeListener
+        {
+            return getChangeTracker<T>().addListener();
+        }
+
+        template<typename T>
+        void removeChangeListener(ChangeListener listener) noexcept
+        {
+            getChangeTracker<T>().removeListener(listener);
+        }
+
+        // Swaps the changes recorded since the previous call into `changes`, recycling its storage
+        template<typename T>
+        void takeChanges(ChangeListener listener, ComponentChanges& changes) noexcept
+        {
+            getChangeTracker<T>().take(listener, changes);
+        }
+
+        void setTransformPropagation(TransformPropagation propagation) noexcept
+        {
+            _transformPropagation = propagation;
+        }
+        [[nodiscard]] auto getTransformPropagation() const noexcept -> TransformPropagation
+        {
+            return _transformPropagation;
+        }
+
+        /* The EntityRelationship links remain the source of truth; eDepthFirst keeps a sorted copy
+         * that turns traversals and recursive propagation into linear scans */
+        void setHierarchyStorage(HierarchyStorage storage) noexcept
+        {
+            _hierarchyStorage = storage;
+        }
+        [[nodiscard]] auto getHierarchyStorage() const noexcept -> HierarchyStorage
+        {
+            return _hierarchyStorage;
+        }
+
         [[nodiscard]] auto registry() noexcept -> Registry& { return _registry; }
         [[nodiscard]] auto registry() const noexcept -> const Registry& { return _registry; }
 
+        [[nodiscard]] auto getMemoryResource() const noexcept -> std::pmr::memory_resource*
+        {
+            return _registry.get_allocator().resource();
+        }
+
         [[nodiscard]] auto isValid(Entity entity) const noexcept -> bool
         {
             return _registry.valid(entity);
@@ -39,12 +185,25 @@ namespace exage
             return _registry.emplace<T>(entity, std::forward<Args>(args)...);
         }
 
+        template<typename T, typename It>
+        void addComponents(std::span<const Entity> entities, It components) noexcept
+        {
+            _registry.insert<T>(entities.begin(), entities.end(), components);
+        }
+
         template<typename T>
         auto getComponent(Entity entity) noexcept -> T&
         {
             return _registry.get<T>(entity);
         }
 
+        // Modifies the component in place and notifies change listeners
+        template<typename T, typename F>
+        void patchComponent(Entity entity, F&& func) noexcept
+        {
+            _registry.patch<T>(entity, std::forward<F>(func));
+        }
+
         template<typename T>
         void removeComponent(Entity entity) noexcept
         {
@@ -57,8 +216,75 @@ namespace exage
             return _registry.all_of<T>(entity);
         }
 
+        // From Transform3D or WorldTransform, as of the last updateHierarchy
+        [[nodiscard]] auto getWorldMatrix(Entity entity) const noexcept
+            -> std::optional<glm::mat4>
+        {
+            if (const auto* transform = _registry.try_get<Transform3D>(entity))
+            {
+                return transform->globalMatrix;
+            }
+            if (const auto* world = _registry.try_get<WorldTransform>(entity))
+            {
+                return world->getMatrix();
+            }
+            return std::nullopt;
+        }
+
         template<typename F>
         void forEachChild(Entity parent, F&& func) noexcept
+        {
+            if (!acquireDepthFirst())
+            {
+                forEachLinkedChild(parent, std::forward<F>(func));
+                return;
+            }
+
+            uint32_t const index = _depthFirst.indices[entt::to_entity(parent)];
+            uint32_t const end = _depthFirst.subtreeEnds[index];
+            for (uint32_t child = index + 1; child < end; child = _depthFirst.subtreeEnds[child])
+            {
+                func(_depthFirst.entities[child]);
+            }
+
+            _depthFirstUsers--;
+        }
+
+        template<typename F>
+        void forEachRoot(F&& func) noexcept
+        {
+            if (!acquireDepthFirst())
+            {
+                auto view = _registry.view<RootEntity>();
+                for (auto entity : view)
+                {
+                    func(entity);
+                }
+                return;
+            }
+
+            auto const count = static_cast<uint32_t>(_depthFirst.entities.size());
+            for (uint32_t root = 0; root < count; root = _depthFirst.subtreeEnds[root])
+            {
+                func(_depthFirst.entities[root]);
+            }
+
+            _depthFirstUsers--;
+        }
+
+        void setParent(Entity entity, Entity parent) noexcept;
+
+      private:
+        auto createLinked(size_t count,
+                          std::span<const size_t> parents,
+                          Entity parent,
+                          std::span<const Entity> externalParents = {}) noexcept
+            -> std::vector<Entity>;
+        void detach(Entity entity, EntityRelationship& relationship) noexcept;
+        auto destroyDetached(std::span<const Entity> subtreeRoots) noexcept -> size_t;
+
+        template<typename F>
+        void forEachLinkedChild(Entity parent, F&& func) noexcept
         {
             auto& relationship = getComponent<EntityRelationship>(parent);
             auto child = relationship.firstChild;
@@ -70,21 +296,76 @@ namespace exage
             }
         }
 
-        template<typename F>
-        void forEachRoot(F&& func) noexcept
+        // Returns false if the linked list must be used instead; release with _depthFirstUsers--
+        auto acquireDepthFirst() noexcept -> bool;
+        void sortDepthFirst() noexcept;
+        auto tryPropagateDepthFirst() noexcept -> bool;
+
+        template<typename T>
+        auto getChangeTracker() noexcept -> ChangeTracker&
         {
-            auto view = _registry.view<RootEntity>();
-            for (auto entity : view)
+            auto [it, inserted] = _changeTrackers.try_emplace(entt::type_hash<T>::value());
+            if (inserted)
             {
-                func(entity);
+                it->second = std::make_unique<ChangeTracker>();
+                it->second->connect<T>(_registry);
             }
+            return *it->second;
         }
 
-        void setParent(Entity entity, Entity parent) noexcept;
+        void recordTransformChange(Entity subtree) noexcept;
+        void recordAllTransformsChanged() noexcept;
 
-      private:
-        void calculateChildTransform(Transform3D& parentTransform, Entity entity) noexcept;
+        // parentRotation is parentTransform's global rotation as getRotationMatrix3 returns it
+        void calculateChildTransform(Transform3D& parentTransform,
+                                     const glm::mat3& parentRotation,
+                                     Entity entity) noexcept;
+        void calculateDirtyTransforms() noexcept;
+        void calculateCompactTransform(const glm::mat4x3* parentWorld, Entity entity) noexcept;
+
+        void flattenHierarchy() noexcept;
+        void propagateFlattened() noexcept;
+
+        struct FlatTransform
+        {
+            Entity entity;
+            Transform3D* transform;
+            const Transform3D* parent;  // nullptr for roots
+        };
+
+        // Before the registry, whose signals point at the trackers, so they outlive it
+        std::unordered_map<entt::id_type, std::unique_ptr<ChangeTracker>> _changeTrackers;
+
+        /* Entities that lost their Transform3D or CompactTransform, so their children get
+         * recomputed. On the heap for the same reason as the trackers, since scenes are movable. */
+        std::unique_ptr<std::vector<Entity>> _removedTransforms =
+            std::make_unique<std::vector<Entity>>();
 
         Registry _registry;
+
+        TransformPropagation _transformPropagation = TransformPropagation::eRecursive;
+        HierarchyStorage _hierarchyStorage = HierarchyStorage::eLinked;
+
+        std::vector<std::optional<TransformChanges>> _transformListeners;  // By listener
+
+        struct DepthFirstHierarchy
+        {
+            static constexpr uint32_t NO_INDEX = std::numeric_limits<uint32_t>::max();
+
+            std::vector<Entity> entities;  // Every subtree is contiguous, parents come first
+            std::vector<uint32_t> parents;  // NO_INDEX for roots
+            std::vector<uint32_t> subtreeEnds;  // One past the last descendant
+            std::vector<uint32_t> indices;  // Position of each entity, by entity identifier
+        };
+
+        DepthFirstHierarchy _depthFirst;
+        bool _depthFirstDirty = true;
+        uint32_t _depthFirstUsers = 0;  // Traversals in flight; the arrays must not be re-sorted
+
+        // Reused between updates to avoid reallocating every frame
+        std::vector<FlatTransform> _flatTransforms;
+        std::vector<size_t> _flatLevels;  // Start of each level in _flatTransforms, then the end
+        std::vector<Transform3D*> _depthFirstTransforms;  // Closest transform at each position
+        std::vector<glm::mat3> _depthFirstRotations;  // Its rotation, only where there are children
     };
 }  // namespace exage
@@ -75,7 +75,7 @@ namespace exage::Graphics
                           uint32_t layerCount) noexcept override;
 
         void beginRendering(std::shared_ptr<FrameBuffer> frameBuffer,
-                            std::vector<ClearColor> clearColors,
+                            std::span<const ClearColor> clearColors,
                             ClearDepthStencil clearDepth) noexcept override;
         void endRendering() noexcept override;
 
@@ -122,8 +122,6 @@ namespace exage::Graphics
                                 uint32_t binding,
                                 Texture::Aspect aspect) noexcept override;
 
-        void userDefined(std::function<void(CommandBuffer&)> commandFunction) noexcept override;
-
         [[nodiscard]] auto getCommandBuffer() const noexcept -> vk::CommandBuffer
         {
             return _commandBuffer;
@@ -132,6 +130,8 @@ namespace exage::Graphics
         EXAGE_VULKAN_DERIVED
 
       private:
+        void recordUserDefined(Commands::UserDefinedCommand command) noexcept override;
+
         void processCommand(const Commands::GPUCommand& command) noexcept;
 
         [[nodiscard]] auto getQueueFamilyIndex(QueueOwnership ownership) noexcept -> uint32_t;
@@ -531,6 +531,12 @@ namespace exage::Graphics
                         return vk::Format::eR8Sint;
                     case VertexAttribute::Type::eI32:
                         return vk::Format::eR32Sint;
+                    case VertexAttribute::Type::eF16:
+                        return vk::Format::eR16Sfloat;
+                    case VertexAttribute::Type::eUnorm16:
+                        return vk::Format::eR16Unorm;
+                    case VertexAttribute::Type::eSnorm16:
+                        return vk::Format::eR16Snorm;
                 }
                 return vk::Format::eR32Uint;
             case 2:
@@ -544,6 +550,12 @@ namespace exage::Graphics
                         return vk::Format::eR8G8Sint;
                     case VertexAttribute::Type::eI32:
                         return vk::Format::eR32G32Sint;
+                    case VertexAttribute::Type::eF16:
+                        return vk::Format::eR16G16Sfloat;
+                    case VertexAttribute::Type::eUnorm16:
+                        return vk::Format::eR16G16Unorm;
+                    case VertexAttribute::Type::eSnorm16:
+                        return vk::Format::eR16G16Snorm;
                 }
                 return vk::Format::eR32G32Uint;
             case 3:
@@ -557,6 +569,12 @@ namespace exage::Graphics
                         return vk::Format::eR8G8B8Sint;
                     case VertexAttribute::Type::eI32:
                         return vk::Format::eR32G32B32Sint;
+                    case VertexAttribute::Type::eF16:
+                        return vk::Format::eR16G16B16Sfloat;
+                    case VertexAttribute::Type::eUnorm16:
+                        return vk::Format::eR16G16B16Unorm;
+                    case VertexAttribute::Type::eSnorm16:
+                        return vk::Format::eR16G16B16Snorm;
                 }
                 return vk::Format::eR32G32B32Uint;
             case 4:
@@ -570,6 +588,12 @@ namespace exage::Graphics
                         return vk::Format::eR8G8B8A8Sint;
                     case VertexAttribute::Type::eI32:
                         return vk::Format::eR32G32B32A32Sint;
+                    case VertexAttribute::Type::eF16:
+                        return vk::Format::eR16G16B16A16Sfloat;
+                    case VertexAttribute::Type::eUnorm16:
+                        return vk::Format::eR16G16B16A16Unorm;
+                    case VertexAttribute::Type::eSnorm16:
+                        return vk::Format::eR16G16B16A16Snorm;
                 }
                 return vk::Format::eR32G32B32A32Uint;
             default:
@@ -1,6 +1,7 @@
 ﻿#pragma once
 
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/quaternion.hpp>
 #include <glm/gtx/euler_angles.hpp>
 #include <glm/gtx/transform.hpp>
 
@@ -52,4 +53,53 @@ namespace exage
         glm::quat rotation = getQuaternionRotation(yawPitchRoll);
         return getViewMatrix(position, rotation, up);
     }
+
+    /* Blends two affine transforms by `alpha`, lerping translation and scale and slerping the
+     * rotation, e.g. an instance's previous and current model by FrameLoop::getInterpolation.
+     * Shear is not preserved. A transform with a zero scale axis has no rotation to recover, and a
+     * mirrored one none that a quaternion can hold, so those are blended column by column. */
+    inline auto interpolateTransform(const glm::mat4& from, const glm::mat4& to, float alpha)
+        -> glm::mat4
+    {
+        if (from == to)
+        {
+            return to;
+        }
+
+        auto getScale = [](const glm::mat4& matrix) -> glm::vec3
+        {
+            return {glm::length(glm::vec3 {matrix[0]}),
+                    glm::length(glm::vec3 {matrix[1]}),
+                    glm::length(glm::vec3 {matrix[2]})};
+        };
+        auto canDecompose = [](const glm::mat4& matrix, glm::vec3 scale)
+        {
+            return glm::min(scale.x, glm::min(scale.y, scale.z)) > SMALL_NUMBER
+                && glm::determinant(glm::mat3 {matrix}) > 0.F;
+        };
+
+        glm::vec3 const fromScale = getScale(from);
+        glm::vec3 const toScale = getScale(to);
+
+        if (!canDecompose(from, fromScale) || !canDecompose(to, toScale))
+        {
+            return from * (1.F - alpha) + to * alpha;
+        }
+
+        auto getRotation = [](const glm::mat4& matrix, glm::vec3 scale) -> glm::quat
+        {
+            return glm::quat_cast(glm::mat3 {glm::vec3 {matrix[0]} / scale.x,
+                                             glm::vec3 {matrix[1]} / scale.y,
+                                             glm::vec3 {matrix[2]} / scale.z});
+        };
+
+        glm::quat const fromRotation = getRotation(from, fromScale);
+        glm::quat const toRotation = getRotation(to, toScale);
+
+        glm::vec3 const position = glm::mix(glm::vec3 {from[3]}, glm::vec3 {to[3]}, alpha);
+        glm::vec3 const scale = glm::mix(fromScale, toScale, alpha);
+        glm::quat const rotation = glm::slerp(fromRotation, toRotation, alpha);
+
+        return glm::translate(position) * glm::mat4_cast(rotation) * glm::scale(scale);
+    }
 }  // namespace exage
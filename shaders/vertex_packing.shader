@@ -0,0 +1,28 @@
+#ifndef VERTEX_PACKING_SHADER_H
+#define VERTEX_PACKING_SHADER_H
+
+// Decoding for the packed vertex formats, matching VertexPacking.cpp
+
+vec2 signNotZero(vec2 value)
+{
+    return vec2(value.x >= 0.0 ? 1.0 : -1.0, value.y >= 0.0 ? 1.0 : -1.0);
+}
+
+// Of a snorm16 pair, as read through the vertex input
+vec3 decodeOctahedral(vec2 encoded)
+{
+    vec3 direction = vec3(encoded, 1.0 - abs(encoded.x) - abs(encoded.y));
+    if (direction.z < 0.0)
+    {
+        direction.xy = (1.0 - abs(direction.yx)) * signNotZero(encoded);
+    }
+    return normalize(direction);
+}
+
+// The low bit of the tangent's second component is set where the bitangent is flipped
+float decodeBitangentSign(vec2 encodedTangent)
+{
+    return (int(round(encodedTangent.y * 32767.0)) & 1) != 0 ? -1.0 : 1.0;
+}
+
+#endif // VERTEX_PACKING_SHADER_H
\ No newline at end of file
@@ -0,0 +1,166 @@
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+
+#include "exage/Core/FrameArena.h"
+
+#include "exage/Core/Debug.h"
+
+namespace exage
+{
+    namespace
+    {
+        auto alignUp(size_t offset, size_t alignment) noexcept -> size_t
+        {
+            return (offset + alignment - 1) & ~(alignment - 1);
+        }
+
+        struct ThreadArenas
+        {
+            std::vector<std::unique_ptr<LinearArena>> frames;  // By frame, created on first use
+        };
+
+        // Every live thread's arenas, so that startFrame can reset them
+        struct Registry
+        {
+            std::mutex mutex;
+            std::vector<ThreadArenas*> threads;
+            std::atomic<uint32_t> currentFrame {0};
+        };
+
+        auto getRegistry() noexcept -> Registry&
+        {
+            static Registry registry;
+            return registry;
+        }
+
+        class ThreadRegistration
+        {
+          public:
+            ThreadRegistration() noexcept
+            {
+                Registry& registry = getRegistry();
+                std::lock_guard const lock {registry.mutex};
+                registry.threads.push_back(&_arenas);
+            }
+
+            ~ThreadRegistration()
+            {
+                Registry& registry = getRegistry();
+                std::lock_guard const lock {registry.mutex};
+                std::erase(registry.threads, &_arenas);
+            }
+
+            EXAGE_DELETE_COPY(ThreadRegistration);
+            EXAGE_DELETE_MOVE(ThreadRegistration);
+
+            auto getArenas() noexcept -> ThreadArenas& { return _arenas; }
+
+          private:
+            ThreadArenas _arenas;
+        };
+    }  // namespace
+
+    LinearArena::LinearArena(size_t blockSize) noexcept
+        : _blockSize(blockSize)
+    {
+        debugAssume(blockSize > 0, "Arena blocks must not be empty");
+    }
+
+    void LinearArena::reset() noexcept
+    {
+        if (_blocks.size() > 1)
+        {
+            size_t const capacity = getCapacity();
+            _blocks.clear();
+            _blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(capacity), capacity});
+        }
+
+        _offset = 0;
+        _used = 0;
+    }
+
+    auto LinearArena::getCapacity() const noexcept -> size_t
+    {
+        size_t capacity = 0;
+        for (const Block& block : _blocks)
+        {
+            capacity += block.size;
+        }
+        return capacity;
+    }
+
+    auto LinearArena::do_allocate(size_t bytes, size_t alignment) -> void*
+    {
+        if (!_blocks.empty())
+        {
+            Block& block = _blocks.back();
+            auto const base = reinterpret_cast<uintptr_t>(block.data.get());
+            size_t const offset = alignUp(base + _offset, alignment) - base;
+            if (offset + bytes <= block.size)
+            {
+                _offset = offset + bytes;
+                return block.data.get() + offset;
+            }
+
+            _used += block.size;
+        }
+
+        // new[] only guarantees the default alignment, so over-aligned requests get some slack
+        size_t const slack = alignment > alignof(std::max_align_t) ? alignment : 0;
+        size_t const size = std::max(_blockSize, bytes + slack);
+        _blocks.push_back({std::make_unique_for_overwrite<std::byte[]>(size), size});
+
+        Block& block = _blocks.back();
+        auto const base = reinterpret_cast<uintptr_t>(block.data.get());
+        size_t const offset = alignUp(base, alignment) - base;
+        _offset = offset + bytes;
+        return block.data.get() + offset;
+    }
+
+    auto FrameArena::get() noexcept -> LinearArena&
+    {
+        thread_local ThreadRegistration registration;
+
+        Registry& registry = getRegistry();
+        uint32_t const frame = registry.currentFrame.load(std::memory_order_acquire);
+
+        ThreadArenas& arenas = registration.getArenas();
+        if (frame >= arenas.frames.size() || !arenas.frames[frame])
+        {
+            // startFrame walks these from another thread
+            std::lock_guard const lock {registry.mutex};
+            if (frame >= arenas.frames.size())
+            {
+                arenas.frames.resize(frame + 1);
+            }
+            arenas.frames[frame] = std::make_unique<LinearArena>();
+        }
+
+        return *arenas.frames[frame];
+    }
+
+    auto FrameArena::getCurrentFrame() noexcept -> uint32_t
+    {
+        return getRegistry().currentFrame.load(std::memory_order_acquire);
+    }
+
+    void FrameArena::startFrame(uint32_t frame) noexcept
+    {
+        Registry& registry = getRegistry();
+
+        {
+            std::lock_guard const lock {registry.mutex};
+            for (ThreadArenas* arenas : registry.threads)
+            {
+                if (frame < arenas->frames.size() && arenas->frames[frame])
+                {
+                    arenas->frames[frame]->reset();
+                }
+            }
+        }
+
+        registry.currentFrame.store(frame, std::memory_order_release);
+    }
+}  // namespace exage
@@ -0,0 +1,55 @@
+#include "exage/Core/FrameLoop.h"
+
+#include "exage/Core/Debug.h"
+
+namespace exage
+{
+    FrameLoop::FrameLoop(Duration step, uint32_t maxStepsPerFrame) noexcept
+        : _step(step)
+        , _maxStepsPerFrame(maxStepsPerFrame)
+    {
+        debugAssume(step.count() > 0, "Simulation step must be positive");
+        debugAssume(maxStepsPerFrame > 0, "At least one step per frame is needed");
+
+        reset();
+    }
+
+    void FrameLoop::reset() noexcept
+    {
+        _lastFrame = Clock::now();
+        _frameTime = Duration {0};
+        _accumulator = Duration {0};
+        _stepCount = 0;
+        _droppedTime = Duration {0};
+    }
+
+    auto FrameLoop::nextFrame() noexcept -> uint32_t
+    {
+        Clock::time_point const now = Clock::now();
+        Duration const frameTime = now - _lastFrame;
+        _lastFrame = now;
+
+        return advance(frameTime);
+    }
+
+    auto FrameLoop::advance(Duration frameTime) noexcept -> uint32_t
+    {
+        _frameTime = frameTime;
+        _accumulator += frameTime;
+
+        Duration::rep steps = _accumulator / _step;
+        if (steps > _maxStepsPerFrame)
+        {
+            // Keep the fraction of a step, so that interpolation stays continuous
+            Duration const dropped = (steps - _maxStepsPerFrame) * _step;
+            _droppedTime += dropped;
+            _accumulator -= dropped;
+            steps = _maxStepsPerFrame;
+        }
+
+        _accumulator -= steps * _step;
+        _stepCount += static_cast<uint64_t>(steps);
+
+        return static_cast<uint32_t>(steps);
+    }
+}  // namespace exage
@@ -0,0 +1,297 @@
+#include "exage/Core/JobSystem.h"
+
+namespace exage
+{
+    namespace
+    {
+        // Which pool, if any, the current thread works for
+        thread_local const JobSystem* currentSystem = nullptr;
+        thread_local size_t currentWorker = 0;
+    }  // namespace
+
+    JobSystem::JobSystem(size_t workerCount) noexcept
+    {
+        _workers.reserve(workerCount);
+        for (size_t i = 0; i < workerCount; i++)
+        {
+            _workers.push_back(std::make_unique<Worker>());
+        }
+
+        // Start the threads only once every deque exists, since they steal from each other
+        for (size_t i = 0; i < workerCount; i++)
+        {
+            _workers[i]->thread = std::jthread {[this, i] { workerLoop(i); }};
+        }
+    }
+
+    JobSystem::~JobSystem()
+    {
+        {
+            std::lock_guard const lock {_sleepMutex};
+            _stopping = true;
+        }
+        _wakeCondition.notify_all();
+
+        for (auto& worker : _workers)
+        {
+            worker->thread.join();
+        }
+    }
+
+    auto JobSystem::getDefault() noexcept -> JobSystem&
+    {
+        static JobSystem jobSystem;
+        return jobSystem;
+    }
+
+    auto JobSystem::defaultWorkerCount() noexcept -> size_t
+    {
+        size_t const hardwareThreads = std::thread::hardware_concurrency();
+        return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+    }
+
+    void JobSystem::submit(const Job& job) noexcept
+    {
+        submit(std::span {&job, 1});
+    }
+
+    void JobSystem::submit(std::span<const Job> jobs) noexcept
+    {
+        if (jobs.empty())
+        {
+            return;
+        }
+
+        for (const Job& job : jobs)
+        {
+            job.counter->_pending.fetch_add(1, std::memory_order_relaxed);
+        }
+
+        if (_workers.empty())
+        {
+            // Nobody to hand the work to; wait() would run it anyway
+            for (const Job& job : jobs)
+            {
+                execute(job);
+            }
+            return;
+        }
+
+        // Counted before they can be popped, so the count cannot drop below zero and wrap; a
+        // tryPop in between finds nothing and returns false
+        _queuedJobs.fetch_add(jobs.size(), std::memory_order_release);
+
+        if (currentSystem == this)
+        {
+            Worker& worker = *_workers[currentWorker];
+            std::lock_guard const lock {worker.mutex};
+            worker.jobs.insert(worker.jobs.end(), jobs.begin(), jobs.end());
+        }
+        else
+        {
+            std::lock_guard const lock {_sharedMutex};
+            _sharedJobs.insert(_sharedJobs.end(), jobs.begin(), jobs.end());
+        }
+
+        wakeWorkers(jobs.size());
+    }
+
+    void JobSystem::wait(JobCounter& counter) noexcept
+    {
+        while (!counter.isDone())
+        {
+            Job job;
+            if (tryPop(job))
+            {
+                execute(job);
+            }
+            else
+            {
+                std::this_thread::yield();
+            }
+        }
+    }
+
+    void JobSystem::workerLoop(size_t index) noexcept
+    {
+        currentSystem = this;
+        currentWorker = index;
+
+        while (true)
+        {
+            Job job;
+            if (tryPop(job))
+            {
+                execute(job);
+                continue;
+            }
+
+            std::unique_lock lock {_sleepMutex};
+            _wakeCondition.wait(lock,
+                                [this] {
+                                    return _stopping
+                                        || _queuedJobs.load(std::memory_order_acquire) > 0;
+                                });
+
+            if (_stopping && _queuedJobs.load(std::memory_order_acquire) == 0)
+            {
+                return;
+            }
+        }
+    }
+
+    auto JobSystem::tryPop(Job& job) noexcept -> bool
+    {
+        if (_queuedJobs.load(std::memory_order_acquire) == 0)
+        {
+            return false;
+        }
+
+        auto popped = [&]
+        {
+            _queuedJobs.fetch_sub(1, std::memory_order_relaxed);
+            return true;
+        };
+
+        bool const isWorker = currentSystem == this;
+        size_t const self = isWorker ? currentWorker : 0;
+
+        // Newest local work first, it is the most likely to still be in cache
+        if (isWorker)
+        {
+            Worker& worker = *_workers[self];
+            std::lock_guard const lock {worker.mutex};
+            if (!worker.jobs.empty())
+            {
+                job = worker.jobs.back();
+                worker.jobs.pop_back();
+                return popped();
+            }
+        }
+
+        {
+            std::lock_guard const lock {_sharedMutex};
+            if (!_sharedJobs.empty())
+            {
+                job = _sharedJobs.front();
+                _sharedJobs.pop_front();
+                return popped();
+            }
+        }
+
+        // Steal the oldest work of the others, which tends to be the largest
+        for (size_t offset = isWorker ? 1 : 0; offset < _workers.size(); offset++)
+        {
+            Worker& victim = *_workers[(self + offset) % _workers.size()];
+            std::lock_guard const lock {victim.mutex};
+            if (!victim.jobs.empty())
+            {
+                job = victim.jobs.front();
+                victim.jobs.pop_front();
+                return popped();
+            }
+        }
+
+        return false;
+    }
+
+    void JobSystem::execute(const Job& job) noexcept
+    {
+        job.invoke(job.data, job.begin, job.end);
+        job.counter->_pending.fetch_sub(1, std::memory_order_acq_rel);
+    }
+
+    void JobSystem::wakeWorkers(size_t jobCount) noexcept
+    {
+        // Taking the lock orders this against a worker checking the queue before it sleeps
+        {
+            std::lock_guard const lock {_sleepMutex};
+        }
+
+        if (jobCount == 1)
+        {
+            _wakeCondition.notify_one();
+        }
+        else
+        {
+            _wakeCondition.notify_all();
+        }
+    }
+
+    auto TaskGraph::addTask(std::function<void()> task) noexcept -> TaskID
+    {
+        _tasks.emplace_back().function = std::move(task);
+        return _tasks.size() - 1;
+    }
+
+    void TaskGraph::addDependency(TaskID before, TaskID after) noexcept
+    {
+        debugAssume(before < _tasks.size() && after < _tasks.size(), "Invalid task ID");
+
+        _tasks[before].successors.push_back(after);
+        _tasks[after].dependencyCount++;
+    }
+
+    void TaskGraph::run(JobSystem& jobSystem) noexcept
+    {
+        _remaining = std::make_unique<std::atomic<uint32_t>[]>(_tasks.size());  // NOLINT
+        _jobSystem = &jobSystem;
+
+        JobCounter counter;
+        _counter = &counter;
+
+        std::vector<Job> ready;
+        for (TaskID task = 0; task < _tasks.size(); task++)
+        {
+            _remaining[task].store(_tasks[task].dependencyCount, std::memory_order_relaxed);
+            if (_tasks[task].dependencyCount == 0)
+            {
+                ready.push_back(makeJob(task));
+            }
+        }
+
+        debugAssert(!ready.empty() || _tasks.empty(), "Task graph has a cycle");
+
+        jobSystem.submit(ready);
+        jobSystem.wait(counter);
+
+#if EXAGE_USE_ASSERTS
+        for (TaskID task = 0; task < _tasks.size(); task++)
+        {
+            debugAssert(_remaining[task].load() == 0, "Task graph has a cycle");
+        }
+#endif
+
+        _jobSystem = nullptr;
+        _counter = nullptr;
+    }
+
+    void TaskGraph::runTask(void* data, size_t index, size_t /*end*/) noexcept
+    {
+        auto& graph = *static_cast<TaskGraph*>(data);
+        Task& task = graph._tasks[index];
+
+        task.function();
+
+        // Successors are submitted before this job counts as done, so the counter cannot hit
+        // zero while part of the graph is still pending
+        for (TaskID successor : task.successors)
+        {
+            if (graph._remaining[successor].fetch_sub(1, std::memory_order_acq_rel) == 1)
+            {
+                graph._jobSystem->submit(graph.makeJob(successor));
+            }
+        }
+    }
+
+    auto TaskGraph::makeJob(TaskID task) noexcept -> Job
+    {
+        return Job {
+            .invoke = &TaskGraph::runTask,
+            .data = this,
+            .begin = task,
+            .end = task + 1,
+            .counter = _counter,
+        };
+    }
+}  // namespace exage
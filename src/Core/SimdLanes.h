@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstddef>
+
+#if defined(__AVX__) || defined(__SSE2__) || defined(_M_X64) \
+    || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#    include <immintrin.h>
+#    define EXAGE_SIMD 1
+#else
+#    define EXAGE_SIMD 0
+#endif
+
+// Thin wrappers over the widest float vectors the build targets, for the Scene kernels and
+// the texture converter. Internal to the library, which has src/ on its include path
+namespace exage::detail
+{
+#if EXAGE_SIMD
+#    ifdef __AVX__
+    using Lanes = __m256;
+    constexpr size_t LANE_COUNT = 8;
+
+    inline auto loadLanes(const float* data) noexcept -> Lanes
+    {
+        return _mm256_load_ps(data);
+    }
+    inline void storeLanes(float* data, Lanes lanes) noexcept
+    {
+        _mm256_store_ps(data, lanes);
+    }
+    inline auto splat(float value) noexcept -> Lanes
+    {
+        return _mm256_set1_ps(value);
+    }
+    inline auto add(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_add_ps(lhs, rhs);
+    }
+    inline auto sub(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_sub_ps(lhs, rhs);
+    }
+    inline auto mul(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_mul_ps(lhs, rhs);
+    }
+    inline auto bitAnd(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_and_ps(lhs, rhs);
+    }
+    inline auto bitAndNot(Lanes mask, Lanes value) noexcept -> Lanes
+    {
+        return _mm256_andnot_ps(mask, value);
+    }
+    inline auto bitOr(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_or_ps(lhs, rhs);
+    }
+    inline auto bitXor(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_xor_ps(lhs, rhs);
+    }
+    inline auto notEqual(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm256_cmp_ps(lhs, rhs, _CMP_NEQ_UQ);
+    }
+    // To the nearest integer, ties to even; only valid within the range of int32_t
+    inline auto roundLanes(Lanes lanes) noexcept -> Lanes
+    {
+        return _mm256_cvtepi32_ps(_mm256_cvtps_epi32(lanes));
+    }
+#    else
+    using Lanes = __m128;
+    constexpr size_t LANE_COUNT = 4;
+
+    inline auto loadLanes(const float* data) noexcept -> Lanes
+    {
+        return _mm_load_ps(data);
+    }
+    inline void storeLanes(float* data, Lanes lanes) noexcept
+    {
+        _mm_store_ps(data, lanes);
+    }
+    inline auto splat(float value) noexcept -> Lanes
+    {
+        return _mm_set1_ps(value);
+    }
+    inline auto add(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_add_ps(lhs, rhs);
+    }
+    inline auto sub(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_sub_ps(lhs, rhs);
+    }
+    inline auto mul(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_mul_ps(lhs, rhs);
+    }
+    inline auto bitAnd(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_and_ps(lhs, rhs);
+    }
+    inline auto bitAndNot(Lanes mask, Lanes value) noexcept -> Lanes
+    {
+        return _mm_andnot_ps(mask, value);
+    }
+    inline auto bitOr(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_or_ps(lhs, rhs);
+    }
+    inline auto bitXor(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_xor_ps(lhs, rhs);
+    }
+    inline auto notEqual(Lanes lhs, Lanes rhs) noexcept -> Lanes
+    {
+        return _mm_cmpneq_ps(lhs, rhs);
+    }
+    // To the nearest integer, ties to even; only valid within the range of int32_t
+    inline auto roundLanes(Lanes lanes) noexcept -> Lanes
+    {
+        return _mm_cvtepi32_ps(_mm_cvtps_epi32(lanes));
+    }
+#    endif
+
+    // Picks `ifSet` where the mask lanes are all ones, `ifClear` elsewhere
+    inline auto select(Lanes mask, Lanes ifSet, Lanes ifClear) noexcept -> Lanes
+    {
+        return bitOr(bitAnd(mask, ifSet), bitAndNot(mask, ifClear));
+    }
+#endif
+}  // namespace exage::detail
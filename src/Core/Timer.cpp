@@ -6,17 +6,17 @@ namespace exage
 {
     namespace
     {
-        std::chrono::time_point<std::chrono::high_resolution_clock> startTime;
+        std::chrono::time_point<std::chrono::steady_clock> startTime;
     }
 
     void Timer::init() noexcept
     {
-        startTime = std::chrono::high_resolution_clock::now();
+        startTime = std::chrono::steady_clock::now();
     }
 
     auto Timer::getTimeFromStart() noexcept -> double
     {
-        return std::chrono::duration<double>(std::chrono::high_resolution_clock::now() - startTime)
+        return std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime)
             .count();
     }
 }  // namespace exage
\ No newline at end of file
@@ -182,8 +182,7 @@ namespace exage::GUI
         {
             case exage::Graphics::API::eVulkan:
             {
-                std::function const commandFunction =
-                    [this](exage::Graphics::CommandBuffer& commandBuffer)
+                auto const commandFunction = [this](exage::Graphics::CommandBuffer& commandBuffer)
                 {
                     vk::CommandBuffer const vkCommand =
                         commandBuffer.as<exage::Graphics::VulkanCommandBuffer>()
@@ -115,11 +115,13 @@ namespace exage::Projects
 
     auto deserializeLevel(SerializedLevel& level) noexcept -> Level
     {
-        Level deserializedLevel;
-        deserializedLevel.path = level.path;
-        deserializedLevel.scene = loadScene(level.entityCount, level.componentData);
+        std::unique_ptr<std::pmr::memory_resource> memory =
+            std::make_unique<std::pmr::unsynchronized_pool_resource>();
+        std::pmr::memory_resource* resource = memory.get();
 
-        return deserializedLevel;
+        return Level {level.path,
+                      std::move(memory),
+                      loadScene(level.entityCount, level.componentData, resource)};
     }
 
     auto serializeLevel(const Level& level) noexcept -> SerializedLevel
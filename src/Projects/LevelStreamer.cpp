@@ -0,0 +1,364 @@
+#include <algorithm>
+#include <iterator>
+#include <utility>
+
+#include "exage/Projects/LevelStreamer.h"
+
+#include "exage/Core/Debug.h"
+#include "exage/Projects/Level.h"
+#include "exage/Projects/Serialization.h"
+#include "exage/Renderer/Scene/Camera.h"
+#include "exage/Renderer/Scene/Light.h"
+#include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Scene/Hierarchy.h"
+
+namespace exage::Projects
+{
+    namespace
+    {
+        // Moves the staged T of a batch into the scene with a single insert
+        template<typename T>
+        void moveComponentsOf(Scene& scene,
+                              Scene::Registry& staging,
+                              std::span<const Entity> staged,
+                              std::span<const Entity> live) noexcept
+        {
+            std::vector<Entity> targets;
+            std::vector<T> components;
+            for (size_t i = 0; i < staged.size(); i++)
+            {
+                if (auto* component = staging.try_get<T>(staged[i]))
+                {
+                    targets.push_back(live[i]);
+                    components.push_back(std::move(*component));
+                }
+            }
+
+            scene.addComponents<T>(targets, std::make_move_iterator(components.begin()));
+        }
+    }  // namespace
+
+    LevelStreamer::LevelStreamer(Scene& scene, JobSystem& jobSystem) noexcept
+        : _scene(scene)
+        , _jobSystem(jobSystem)
+    {
+    }
+
+    LevelStreamer::~LevelStreamer()
+    {
+        for (auto& level : _levels)
+        {
+            if (level)
+            {
+                _jobSystem.wait(level->loading);
+            }
+        }
+    }
+
+    auto LevelStreamer::load(std::filesystem::path path) noexcept -> LevelID
+    {
+        auto free = std::find(_levels.begin(), _levels.end(), nullptr);
+        if (free == _levels.end())
+        {
+            free = _levels.emplace(_levels.end());
+        }
+
+        *free = std::make_unique<StreamedLevel>();
+        StreamedLevel& level = **free;
+        level.path = std::move(path);
+
+        _jobSystem.submit(Job {
+            .invoke = &LevelStreamer::loadJob,
+            .data = &level,
+            .begin = 0,
+            .end = 1,
+            .counter = &level.loading,
+        });
+
+        return static_cast<LevelID>(free - _levels.begin());
+    }
+
+    void LevelStreamer::unload(LevelID level) noexcept
+    {
+        getLevel(level);  // Validates the ID
+        StreamedLevel& streamed = *_levels[level];
+
+        switch (streamed.state)
+        {
+            case StreamingState::eLoading:
+                streamed.discard = true;
+                break;
+            case StreamingState::eStaged:
+                releaseStaging(streamed);
+                if (streamed.root == entt::null)
+                {
+                    _levels[level].reset();
+                }
+                else
+                {
+                    streamed.state = StreamingState::eUnloading;
+                }
+                break;
+            case StreamingState::eLoaded:
+                streamed.state = StreamingState::eUnloading;
+                break;
+            case StreamingState::eUnloading:
+                break;
+            case StreamingState::eFailed:
+                _levels[level].reset();
+                break;
+        }
+    }
+
+    auto LevelStreamer::commit(std::chrono::microseconds budget) noexcept -> bool
+    {
+        Deadline const deadline = std::chrono::steady_clock::now() + budget;
+
+        for (auto& level : _levels)
+        {
+            if (!level || level->state != StreamingState::eLoading || !level->loading.isDone())
+            {
+                continue;
+            }
+
+            if (level->discard)
+            {
+                level.reset();
+            }
+            else if (level->error)
+            {
+                level->state = StreamingState::eFailed;
+            }
+            else
+            {
+                level->state = StreamingState::eStaged;
+            }
+        }
+
+        // Every call makes some progress, even when the budget is already spent
+        bool started = false;
+        auto outOfTime = [&]
+        { return std::exchange(started, true) && std::chrono::steady_clock::now() >= deadline; };
+
+        // Unloads go first, so that a level swapped for another one frees its entities before the
+        // new one adds its own
+        for (auto& level : _levels)
+        {
+            if (!level || level->state != StreamingState::eUnloading)
+            {
+                continue;
+            }
+
+            if (outOfTime() || !commitUnload(*level, deadline))
+            {
+                return false;
+            }
+            level.reset();
+        }
+
+        for (auto& level : _levels)
+        {
+            if (!level || level->state != StreamingState::eStaged)
+            {
+                continue;
+            }
+
+            if (outOfTime() || !commitStaged(*level, deadline))
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    auto LevelStreamer::getState(LevelID level) const noexcept -> StreamingState
+    {
+        return getLevel(level).state;
+    }
+
+    auto LevelStreamer::getRoot(LevelID level) const noexcept -> Entity
+    {
+        return getLevel(level).root;
+    }
+
+    auto LevelStreamer::getError(LevelID level) const noexcept -> std::optional<Error>
+    {
+        return getLevel(level).error;
+    }
+
+    void LevelStreamer::loadJob(void* data, size_t /*begin*/, size_t /*end*/) noexcept
+    {
+        auto& level = *static_cast<StreamedLevel*>(data);
+
+        auto serialized = loadLevel(level.path);
+        if (!serialized)
+        {
+            level.error = serialized.error();
+            return;
+        }
+
+        level.memory = std::make_unique<std::pmr::unsynchronized_pool_resource>();
+
+        try
+        {
+            level.staging.emplace(loadScene(
+                serialized->entityCount, serialized->componentData, level.memory.get()));
+        }
+        catch (const std::exception&)
+        {
+            level.error = Errors::DeserializationFailed {};
+            return;
+        }
+
+        // Breadth first, so that every parent is committed before its children
+        Scene& staging = *level.staging;
+        staging.updateHierarchy(false);
+
+        staging.forEachRoot(
+            [&](Entity entity)
+            {
+                level.order.push_back(entity);
+                level.parents.push_back(NO_PARENT);
+            });
+
+        for (size_t i = 0; i < level.order.size(); i++)
+        {
+            auto const parent = static_cast<uint32_t>(i);
+            staging.forEachChild(level.order[i],
+                                 [&](Entity child)
+                                 {
+                                     level.order.push_back(child);
+                                     level.parents.push_back(parent);
+                                 });
+        }
+
+        level.entities.reserve(level.order.size());
+    }
+
+    auto LevelStreamer::commitStaged(StreamedLevel& level, Deadline deadline) noexcept -> bool
+    {
+        if (level.root == entt::null)
+        {
+            level.root = _scene.createEntity();
+            _scene.addComponent<Transform3D>(level.root);
+        }
+
+        // Each batch is instantiated as a prefab, whose nodes hang below either another node of
+        // the batch or an entity committed before it
+        ScenePrefab batch;
+        batch.parents.reserve(BATCH_SIZE);
+        batch.externalParents.reserve(BATCH_SIZE);
+
+        while (level.entities.size() < level.order.size())
+        {
+            size_t const begin = level.entities.size();
+            size_t const end = std::min(begin + BATCH_SIZE, level.order.size());
+
+            batch.parents.clear();
+            batch.externalParents.clear();
+            for (size_t i = begin; i < end; i++)
+            {
+                uint32_t const parent = level.parents[i];
+                if (parent != NO_PARENT && parent >= begin)
+                {
+                    batch.parents.push_back(parent - begin);
+                    batch.externalParents.push_back(entt::null);
+                }
+                else
+                {
+                    batch.parents.push_back(ScenePrefab::NO_PARENT);
+                    batch.externalParents.push_back(parent == NO_PARENT ? level.root
+                                                                        : level.entities[parent]);
+                }
+            }
+
+            std::vector<Entity> const live = _scene.instantiate(batch);
+            moveComponents(level, std::span {level.order}.subspan(begin, end - begin), live);
+            level.entities.insert(level.entities.end(), live.begin(), live.end());
+
+            if (level.entities.size() < level.order.size()
+                && std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+        }
+
+        level.state = StreamingState::eLoaded;
+        releaseStaging(level);
+
+        return true;
+    }
+
+    auto LevelStreamer::commitUnload(StreamedLevel& level, Deadline deadline) noexcept -> bool
+    {
+        // Children before their parents, so that each batch only destroys what it names and
+        // whatever was parented to it since
+        std::vector<Entity> batch;
+        batch.reserve(BATCH_SIZE);
+
+        while (!level.entities.empty())
+        {
+            batch.clear();
+            while (!level.entities.empty() && batch.size() < BATCH_SIZE)
+            {
+                Entity const entity = level.entities.back();
+                level.entities.pop_back();
+
+                if (_scene.isValid(entity))
+                {
+                    batch.push_back(entity);
+                }
+            }
+
+            _scene.destroySubtrees(batch);
+
+            if (!level.entities.empty() && std::chrono::steady_clock::now() >= deadline)
+            {
+                return false;
+            }
+        }
+
+        if (_scene.isValid(level.root))
+        {
+            _scene.destroySubtrees({&level.root, 1});
+        }
+
+        return true;
+    }
+
+    void LevelStreamer::moveComponents(StreamedLevel& level,
+                                       std::span<const Entity> staged,
+                                       std::span<const Entity> live) noexcept
+    {
+        Scene::Registry& staging = level.staging->registry();
+
+#define MOVE_COMPONENT(T) moveComponentsOf<T>(_scene, staging, staged, live)
+
+        MOVE_COMPONENT(exage::Transform3D);
+        MOVE_COMPONENT(exage::CompactTransform);
+        MOVE_COMPONENT(exage::Renderer::Camera);
+        MOVE_COMPONENT(exage::Renderer::StaticMeshComponent);
+        MOVE_COMPONENT(exage::Renderer::PrefabInstance);
+        MOVE_COMPONENT(exage::Renderer::DirectionalLight);
+        MOVE_COMPONENT(exage::Renderer::PointLight);
+        MOVE_COMPONENT(exage::Renderer::SpotLight);
+
+#undef MOVE_COMPONENT
+    }
+
+    void LevelStreamer::releaseStaging(StreamedLevel& level) noexcept
+    {
+        level.staging.reset();
+        level.memory.reset();
+        level.order = {};
+        level.parents = {};
+    }
+
+    auto LevelStreamer::getLevel(LevelID level) const noexcept -> const StreamedLevel&
+    {
+        debugAssume(level < _levels.size() && _levels[level], "Invalid level");
+        return *_levels[level];
+    }
+}  // namespace exage::Projects
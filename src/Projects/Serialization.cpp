@@ -1,4 +1,5 @@
 #include <fstream>
+#include <memory_resource>
 #include <string>
 #include <string_view>
 #include <unordered_map>
@@ -6,6 +7,7 @@
 
 #include "exage/Projects/Serialization.h"
 
+#include <cereal/types/vector.hpp>
 #include <entt/core/hashed_string.hpp>
 #include <entt/entity/entity.hpp>
 #include <entt/entity/fwd.hpp>
@@ -14,21 +16,24 @@
 #include <exage/utils/serialization.h>
 
 #include "cereal/archives/binary.hpp"
+#include "exage/Core/FrameArena.h"
 #include "exage/Projects/Level.h"
 #include "exage/Renderer/Scene/Camera.h"
 #include "exage/Renderer/Scene/Light.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/Prefab.h"
 #include "exage/Scene/Hierarchy.h"
 
 namespace exage::Projects
 {
     namespace
     {
+        using EntityIndices = std::pmr::unordered_map<Entity, uint32_t>;
+
         template<typename T>
-        auto serializeStorageWithCereal(
-            entt::id_type id,
-            const entt::sparse_set& storage,
-            std::unordered_map<Entity, uint32_t>& entityToIndex) noexcept
+        auto serializeStorageWithCereal(entt::id_type id,
+                                        const Scene::Storage& storage,
+                                        EntityIndices& entityToIndex) noexcept
             -> std::optional<ComponentData>
         {
             if (id == entt::type_hash<T, void>::value())
@@ -86,8 +91,8 @@ namespace exage::Projects
         }  // namespace
 
         auto serializeStorage(entt::id_type id,
-                              const entt::sparse_set& storage,
-                              std::unordered_map<Entity, uint32_t>& entityToIndex) noexcept
+                              const Scene::Storage& storage,
+                              EntityIndices& entityToIndex) noexcept
             -> std::optional<std::pair<std::string, ComponentData>>
         {
             if (id == entt::type_hash<EntityRelationship, void>::value())
@@ -168,8 +173,10 @@ namespace exage::Projects
     }
 
             SERIALIZE_STORAGE(exage::Transform3D);
+            SERIALIZE_STORAGE(exage::CompactTransform);
             SERIALIZE_STORAGE(exage::Renderer::Camera);
             SERIALIZE_STORAGE(exage::Renderer::StaticMeshComponent);
+            SERIALIZE_STORAGE(exage::Renderer::PrefabInstance);
             SERIALIZE_STORAGE(exage::Renderer::DirectionalLight);
             SERIALIZE_STORAGE(exage::Renderer::PointLight);
             SERIALIZE_STORAGE(exage::Renderer::SpotLight);
@@ -201,7 +208,9 @@ namespace exage::Projects
     {
         auto& reg = scene.registry();
 
-        std::unordered_map<Entity, uint32_t> entityToIndex;
+        // Only needed while serializing, so it comes from a scratch arena released in one go
+        LinearArena scratch;
+        EntityIndices entityToIndex {&scratch};
 
         uint32_t entityCount = 0;
         reg.each(
@@ -234,7 +243,7 @@ namespace exage::Projects
         void deserializeStorageWithCereal(
             const std::unordered_map<uint32_t, Entity>& indexToEntity,
             const std::unordered_map<uint32_t, std::string>& componentData,
-            entt::registry& reg)
+            Scene::Registry& reg)
         {
             for (const auto& [index, data] : componentData)
             {
@@ -261,9 +270,10 @@ namespace exage::Projects
     }  // namespace
 
     auto loadScene(uint32_t entityCount,
-                   const std::unordered_map<std::string, ComponentData>& componentData) -> Scene
+                   const std::unordered_map<std::string, ComponentData>& componentData,
+                   std::pmr::memory_resource* resource) -> Scene
     {
-        Scene scene;
+        Scene scene {resource};
 
         scene.registry().reserve(entityCount);
 
@@ -320,11 +330,17 @@ namespace exage::Projects
                         component.childCount = mappedComponent.childCount;
 
                         scene.registry().emplace_or_replace<EntityRelationship>(entity, component);
+
+                        if (component.parent == entt::null)
+                        {
+                            scene.registry().emplace_or_replace<RootEntity>(entity);
+                        }
                     }
 
                     catch (const std::exception&)
                     {
                         scene.registry().emplace_or_replace<EntityRelationship>(entity);
+                        scene.registry().emplace_or_replace<RootEntity>(entity);
                     }
                 }
 
@@ -339,8 +355,10 @@ namespace exage::Projects
     }
 
             DESERIALIZE_STORAGE(exage::Transform3D);
+            DESERIALIZE_STORAGE(exage::CompactTransform);
             DESERIALIZE_STORAGE(exage::Renderer::Camera);
             DESERIALIZE_STORAGE(exage::Renderer::StaticMeshComponent);
+            DESERIALIZE_STORAGE(exage::Renderer::PrefabInstance);
             DESERIALIZE_STORAGE(exage::Renderer::DirectionalLight);
             DESERIALIZE_STORAGE(exage::Renderer::PointLight);
             DESERIALIZE_STORAGE(exage::Renderer::SpotLight);
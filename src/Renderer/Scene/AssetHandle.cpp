@@ -0,0 +1,84 @@
+#include <deque>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+
+#include "exage/Renderer/Scene/AssetHandle.h"
+
+#include "exage/Core/Debug.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        struct AssetRegistry
+        {
+            std::shared_mutex mutex;
+
+            // A deque never moves its strings, so the views keyed on them stay valid
+            std::deque<std::string> paths;
+            std::unordered_map<std::string_view, uint32_t> indices;
+        };
+
+        auto getRegistry() noexcept -> AssetRegistry&
+        {
+            static AssetRegistry registry;
+            return registry;
+        }
+
+        auto find(const AssetRegistry& registry, std::string_view path) noexcept -> AssetHandle
+        {
+            auto it = registry.indices.find(path);
+            return it != registry.indices.end() ? AssetHandle {it->second} : AssetHandle {};
+        }
+    }  // namespace
+
+    auto internAsset(std::string_view path) noexcept -> AssetHandle
+    {
+        AssetRegistry& registry = getRegistry();
+
+        {
+            std::shared_lock lock {registry.mutex};
+            if (AssetHandle handle = find(registry, path); handle.isValid())
+            {
+                return handle;
+            }
+        }
+
+        std::unique_lock lock {registry.mutex};
+
+        // Another thread may have interned it between the two locks
+        if (AssetHandle handle = find(registry, path); handle.isValid())
+        {
+            return handle;
+        }
+
+        auto const index = static_cast<uint32_t>(registry.paths.size());
+        debugAssume(index != AssetHandle::NULL_INDEX, "Too many asset paths interned");
+
+        const std::string& interned = registry.paths.emplace_back(path);
+        registry.indices.emplace(interned, index);
+        return AssetHandle {index};
+    }
+
+    auto findAsset(std::string_view path) noexcept -> AssetHandle
+    {
+        AssetRegistry& registry = getRegistry();
+        std::shared_lock lock {registry.mutex};
+        return find(registry, path);
+    }
+
+    auto getAssetPath(AssetHandle handle) noexcept -> const std::string&
+    {
+        static const std::string empty;
+        if (!handle.isValid())
+        {
+            return empty;
+        }
+
+        AssetRegistry& registry = getRegistry();
+        std::shared_lock lock {registry.mutex};
+        debugAssume(handle.index < registry.paths.size(), "Invalid asset handle");
+        return registry.paths[handle.index];
+    }
+}  // namespace exage::Renderer
@@ -0,0 +1,289 @@
+#include "exage/Renderer/Scene/BoundingVolumeHierarchy.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        // Keeps flat or point-sized boxes from being reinserted on every move
+        constexpr float MIN_FAT_MARGIN = 0.01F;
+
+        // A fat box grown past this many margins around its entity is shrunk back down
+        constexpr float MAX_FAT_MARGINS = 4.F;
+
+        auto enlarge(const AABB& bounds, float margins) noexcept -> AABB
+        {
+            glm::vec3 const size = glm::vec3 {bounds.max - bounds.min};
+            glm::vec3 const margin =
+                glm::max(size * BoundingVolumeHierarchy::FAT_MARGIN, glm::vec3 {MIN_FAT_MARGIN})
+                * margins;
+
+            return {bounds.min - glm::vec4 {margin, 0.F}, bounds.max + glm::vec4 {margin, 0.F}};
+        }
+    }  // namespace
+
+    void BoundingVolumeHierarchy::update(Entity entity, const AABB& bounds) noexcept
+    {
+        uint32_t leaf = findLeaf(entity);
+
+        if (leaf != NULL_NODE)
+        {
+            const AABB& fat = _nodes[leaf].bounds;
+            if (encloses(fat, bounds) && encloses(enlarge(bounds, MAX_FAT_MARGINS), fat))
+            {
+                return;
+            }
+
+            removeLeaf(leaf);
+        }
+        else
+        {
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= _leaves.size())
+            {
+                _leaves.resize(id + 1, NULL_NODE);
+            }
+
+            // A destroyed entity whose identifier was recycled is dropped first
+            if (_leaves[id] != NULL_NODE)
+            {
+                remove(_nodes[_leaves[id]].entity);
+            }
+
+            leaf = allocateNode();
+            _nodes[leaf].entity = entity;
+            _leaves[id] = leaf;
+            _leafCount++;
+        }
+
+        _nodes[leaf].bounds = enlarge(bounds, 1.F);
+        insertLeaf(leaf);
+    }
+
+    void BoundingVolumeHierarchy::remove(Entity entity) noexcept
+    {
+        uint32_t const leaf = findLeaf(entity);
+        if (leaf == NULL_NODE)
+        {
+            return;
+        }
+
+        removeLeaf(leaf);
+        freeNode(leaf);
+
+        _leaves[static_cast<size_t>(entt::to_entity(entity))] = NULL_NODE;
+        _leafCount--;
+    }
+
+    void BoundingVolumeHierarchy::clear() noexcept
+    {
+        _nodes.clear();
+        _leaves.clear();
+        _root = NULL_NODE;
+        _freeList = NULL_NODE;
+        _leafCount = 0;
+    }
+
+    auto BoundingVolumeHierarchy::allocateNode() noexcept -> uint32_t
+    {
+        if (_freeList == NULL_NODE)
+        {
+            _nodes.emplace_back();
+            return static_cast<uint32_t>(_nodes.size() - 1);
+        }
+
+        uint32_t const node = _freeList;
+        _freeList = _nodes[node].parent;
+        _nodes[node] = Node {};
+        return node;
+    }
+
+    void BoundingVolumeHierarchy::freeNode(uint32_t node) noexcept
+    {
+        _nodes[node] = Node {};
+        _nodes[node].parent = _freeList;
+        _freeList = node;
+    }
+
+    void BoundingVolumeHierarchy::insertLeaf(uint32_t leaf) noexcept
+    {
+        if (_root == NULL_NODE)
+        {
+            _root = leaf;
+            _nodes[leaf].parent = NULL_NODE;
+            return;
+        }
+
+        // Walk down to the cheapest sibling by the surface area heuristic, where every node on the
+        // way pays for growing to fit the new leaf
+        AABB const bounds = _nodes[leaf].bounds;
+        uint32_t sibling = _root;
+
+        while (!_nodes[sibling].isLeaf())
+        {
+            const Node& node = _nodes[sibling];
+
+            float const area = getHalfArea(node.bounds);
+            float const combinedArea = getHalfArea(getUnion(node.bounds, bounds));
+
+            float const pairCost = 2.F * combinedArea;
+            float const inheritedCost = 2.F * (combinedArea - area);
+
+            auto descendCost = [&](uint32_t index)
+            {
+                const Node& child = _nodes[index];
+                float const grownArea = getHalfArea(getUnion(child.bounds, bounds));
+                return child.isLeaf() ? grownArea + inheritedCost
+                                      : grownArea - getHalfArea(child.bounds) + inheritedCost;
+            };
+
+            float const cost0 = descendCost(node.children[0]);
+            float const cost1 = descendCost(node.children[1]);
+
+            if (pairCost < cost0 && pairCost < cost1)
+            {
+                break;
+            }
+
+            sibling = cost0 < cost1 ? node.children[0] : node.children[1];
+        }
+
+        uint32_t const oldParent = _nodes[sibling].parent;
+        uint32_t const newParent = allocateNode();
+
+        Node& parent = _nodes[newParent];
+        parent.parent = oldParent;
+        parent.bounds = getUnion(bounds, _nodes[sibling].bounds);
+        parent.height = _nodes[sibling].height + 1;
+        parent.children = {sibling, leaf};
+
+        _nodes[sibling].parent = newParent;
+        _nodes[leaf].parent = newParent;
+
+        if (oldParent == NULL_NODE)
+        {
+            _root = newParent;
+        }
+        else
+        {
+            auto& children = _nodes[oldParent].children;
+            children[children[0] == sibling ? 0 : 1] = newParent;
+        }
+
+        refitAncestors(_nodes[newParent].parent);
+    }
+
+    void BoundingVolumeHierarchy::removeLeaf(uint32_t leaf) noexcept
+    {
+        if (leaf == _root)
+        {
+            _root = NULL_NODE;
+            return;
+        }
+
+        uint32_t const parent = _nodes[leaf].parent;
+        uint32_t const grandParent = _nodes[parent].parent;
+        auto const& siblings = _nodes[parent].children;
+        uint32_t const sibling = siblings[siblings[0] == leaf ? 1 : 0];
+
+        freeNode(parent);
+        _nodes[leaf].parent = NULL_NODE;
+        _nodes[sibling].parent = grandParent;
+
+        if (grandParent == NULL_NODE)
+        {
+            _root = sibling;
+            return;
+        }
+
+        auto& children = _nodes[grandParent].children;
+        children[children[0] == parent ? 0 : 1] = sibling;
+
+        refitAncestors(grandParent);
+    }
+
+    void BoundingVolumeHierarchy::refitAncestors(uint32_t node) noexcept
+    {
+        while (node != NULL_NODE)
+        {
+            node = rotate(node);
+
+            Node& current = _nodes[node];
+            const Node& child0 = _nodes[current.children[0]];
+            const Node& child1 = _nodes[current.children[1]];
+
+            current.bounds = getUnion(child0.bounds, child1.bounds);
+            current.height = 1 + std::max(child0.height, child1.height);
+
+            node = current.parent;
+        }
+    }
+
+    /* If one child of A is more than one level taller than the other, the taller child takes A's
+     * place and A adopts the shorter of that child's children. Returns the node now in A's place.
+     *
+     *       A              C
+     *      / \            / \
+     *     B   C    ->    A   F      (when F is taller than G)
+     *        / \        / \
+     *       F   G      B   G
+     */
+    auto BoundingVolumeHierarchy::rotate(uint32_t a) noexcept -> uint32_t
+    {
+        Node& nodeA = _nodes[a];
+        if (nodeA.isLeaf() || nodeA.height < 2)
+        {
+            return a;
+        }
+
+        auto const balance = static_cast<int64_t>(_nodes[nodeA.children[1]].height)
+            - static_cast<int64_t>(_nodes[nodeA.children[0]].height);
+
+        if (balance >= -1 && balance <= 1)
+        {
+            return a;
+        }
+
+        // The taller child rises; `side` is its place under A, `other` the shorter one's
+        size_t const side = balance > 1 ? 1 : 0;
+        size_t const other = 1 - side;
+
+        uint32_t const c = nodeA.children[side];
+        Node& nodeC = _nodes[c];
+
+        uint32_t const f = nodeC.children[0];
+        uint32_t const g = nodeC.children[1];
+
+        // C takes A's place
+        nodeC.parent = nodeA.parent;
+        nodeA.parent = c;
+
+        if (nodeC.parent == NULL_NODE)
+        {
+            _root = c;
+        }
+        else
+        {
+            auto& children = _nodes[nodeC.parent].children;
+            children[children[0] == a ? 0 : 1] = c;
+        }
+
+        // C keeps its taller child and hands the shorter one to A
+        bool const keepF = _nodes[f].height > _nodes[g].height;
+        uint32_t const kept = keepF ? f : g;
+        uint32_t const given = keepF ? g : f;
+
+        nodeC.children[other] = a;
+        nodeC.children[side] = kept;
+        nodeA.children[side] = given;
+        _nodes[given].parent = a;
+
+        const Node& shorter = _nodes[nodeA.children[other]];
+        nodeA.bounds = getUnion(shorter.bounds, _nodes[given].bounds);
+        nodeA.height = 1 + std::max(shorter.height, _nodes[given].height);
+
+        nodeC.bounds = getUnion(nodeA.bounds, _nodes[kept].bounds);
+        nodeC.height = 1 + std::max(nodeA.height, _nodes[kept].height);
+
+        return c;
+    }
+}  // namespace exage::Renderer
@@ -1,10 +1,29 @@
-﻿#include <cstddef>
+﻿#include <array>
+#include <cstddef>
+#include <cstring>
 #include <filesystem>
 #include <fstream>
 #include <memory>
 #include <unordered_map>
 #include <vector>
 
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#    include <immintrin.h>
+#    define EXAGE_X86 1
+#    ifdef _MSC_VER
+#        include <intrin.h>
+#    endif
+#else
+#    define EXAGE_X86 0
+#endif
+
+// GCC and Clang only compile intrinsics into functions that target their ISA; MSVC needs no flag
+#if defined(__GNUC__) || defined(__clang__)
+#    define EXAGE_TARGET(isa) __attribute__((target(isa)))
+#else
+#    define EXAGE_TARGET(isa)
+#endif
+
 #include "exage/Renderer/Scene/Loader/Converter.h"
 
 #include <FreeImage.h>
@@ -23,12 +42,14 @@
 #include <zstd.h>
 
 #include "exage/Core/Errors.h"
+#include "exage/Core/JobSystem.h"
 #include "exage/Filesystem/Directories.h"
 #include "exage/Graphics/Texture.h"
 #include "exage/Renderer/Scene/Loader/AssetFile.h"
 #include "exage/Renderer/Scene/Loader/Loader.h"
 #include "exage/Renderer/Scene/Material.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/VertexPacking.h"
 #include "exage/Scene/Hierarchy.h"
 #include "exage/platform/Vulkan/VulkanUtils.h"
 // #include "ktxvulkan.h"
@@ -170,9 +191,12 @@ namespace exage::Renderer
             return meshResult;
         }
 
-        [[nodiscard]] auto processNode2(const aiNode& node,
-                                        std::vector<AssetImportResult2::Node>& nodes,
-                                        size_t parent) noexcept -> std::vector<size_t>
+        // Appends the nodes made from `node` to `siblings`, instead of returning them in a vector
+        // of their own for every node of the tree
+        void processNode2(const aiNode& node,
+                          std::vector<AssetImportResult2::Node>& nodes,
+                          size_t parent,
+                          std::vector<size_t>& siblings) noexcept
         {
             Transform3D transform;
             // decompose aiMatrix4x4 into glm::vec3 and glm::quat
@@ -187,12 +211,8 @@ namespace exage::Renderer
             transform.rotation = glm::quat(aiRotation.w, aiRotation.x, aiRotation.y, aiRotation.z);
             transform.position = glm::vec3(aiTranslation.x, aiTranslation.y, aiTranslation.z);
 
-            std::vector<size_t> nodes2;
-
             if (node.mNumMeshes > 0)
             {
-                nodes2.reserve(node.mNumMeshes);
-
                 for (size_t i = 0; i < node.mNumMeshes; i++)
                 {
                     AssetImportResult2::Node nodeResult;
@@ -201,7 +221,7 @@ namespace exage::Renderer
 
                     nodeResult.meshIndex = node.mMeshes[i];
 
-                    nodes2.push_back(nodes.size());
+                    siblings.push_back(nodes.size());
 
                     nodes.push_back(std::move(nodeResult));
                 }
@@ -211,10 +231,10 @@ namespace exage::Renderer
                 if (node.mNumChildren == 0)
                 {
                     // If there are no meshes and no children, then this node is useless
-                    return {};
+                    return;
                 }
 
-                nodes2.push_back(nodes.size());
+                siblings.push_back(nodes.size());
 
                 nodes.push_back(AssetImportResult2::Node {
                     .transform = transform,
@@ -222,24 +242,22 @@ namespace exage::Renderer
                 });
             }
 
+            size_t const self = siblings.back();
+
             std::vector<size_t> children;
             children.reserve(node.mNumChildren);
 
             for (size_t i = 0; i < node.mNumChildren; i++)
             {
-                auto childNodes = processNode2(*node.mChildren[i], nodes, nodes2.back());
-                children.insert(children.end(),
-                                std::make_move_iterator(childNodes.begin()),
-                                std::make_move_iterator(childNodes.end()));
+                processNode2(*node.mChildren[i], nodes, self, children);
             }
 
-            nodes[nodes2.back()].childrenIndices = std::move(children);
-
-            return nodes2;
+            nodes[self].childrenIndices = std::move(children);
         }
 
         [[nodiscard]] auto processScene2(const std::filesystem::path& assetPath,
-                                         const aiScene& scene) noexcept -> AssetImportResult2
+                                         const aiScene& scene,
+                                         ImportProgress& progress) noexcept -> AssetImportResult2
         {
             AssetImportResult2 result;
 
@@ -255,27 +273,216 @@ namespace exage::Renderer
                     processMaterial2(assetDirectory, *material, result.textures, textureCache));
             }
 
-            for (size_t i = 0; i < scene.mNumMeshes; ++i)
-            {
-                const auto* mesh = scene.mMeshes[i];
+            // Meshes are independent of each other, and the bulk of the work
+            result.meshes.resize(scene.mNumMeshes);
+            progress.addSteps(scene.mNumMeshes);
 
-                result.meshes.push_back(processMesh2(*mesh));
-            }
+            JobSystem::getDefault().parallelFor(
+                scene.mNumMeshes,
+                1,
+                [&](size_t first, size_t last)
+                {
+                    for (size_t i = first; i < last && !progress.isCancelled(); i++)
+                    {
+                        result.meshes[i] = processMesh2(*scene.mMeshes[i]);
+                        progress.completeStep();
+                    }
+                });
 
             const auto* root = scene.mRootNode;
 
             if (root != nullptr)
             {
-                result.rootNodes =
-                    processNode2(*root, result.nodes, std::numeric_limits<size_t>::max());
+                processNode2(
+                    *root, result.nodes, std::numeric_limits<size_t>::max(), result.rootNodes);
             }
 
             return result;
         }
 
+#if FREEIMAGE_COLORORDER != FREEIMAGE_COLORORDER_RGB
+        // Each swizzles as many whole vectors of BGRA pixels as fit and returns how many it did
+        using RgbaSwizzle = size_t (*)(const uint8_t*, uint8_t*, size_t) noexcept;
+
+        auto swizzleRgbaScalar(const uint8_t* /*source*/,
+                               uint8_t* /*destination*/,
+                               size_t /*width*/) noexcept -> size_t
+        {
+            return 0;
+        }
+
+#    if EXAGE_X86
+        EXAGE_TARGET("ssse3")
+        auto swizzleRgbaSsse3(const uint8_t* source, uint8_t* destination, size_t width) noexcept
+            -> size_t
+        {
+            __m128i const swizzle =
+                _mm_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+
+            size_t x = 0;
+            for (; x + 4 <= width; x += 4)
+            {
+                __m128i const pixels =
+                    _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + x * 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(destination + x * 4),
+                                 _mm_shuffle_epi8(pixels, swizzle));
+            }
+            return x;
+        }
+
+        EXAGE_TARGET("avx2")
+        auto swizzleRgbaAvx2(const uint8_t* source, uint8_t* destination, size_t width) noexcept
+            -> size_t
+        {
+            __m256i const swizzle = _mm256_setr_epi8(2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13,
+                                                     12, 15, 2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11,
+                                                     14, 13, 12, 15);
+
+            size_t x = 0;
+            for (; x + 8 <= width; x += 8)
+            {
+                __m256i const pixels =
+                    _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + x * 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i*>(destination + x * 4),
+                                    _mm256_shuffle_epi8(pixels, swizzle));
+            }
+            return x;
+        }
+#    endif
+
+        // Picked at run time, so builds for baseline x86-64 still use the CPU's shuffles
+        auto selectRgbaSwizzle() noexcept -> RgbaSwizzle
+        {
+#    if EXAGE_X86 && defined(_MSC_VER)
+            std::array<int, 4> info {};
+            __cpuid(info.data(), 0);
+            int const maxLeaf = info[0];
+
+            __cpuid(info.data(), 1);
+            bool const ssse3 = (info[2] & (1 << 9)) != 0;
+            bool const osAvx = (info[2] & (1 << 27)) != 0 && (info[2] & (1 << 28)) != 0
+                && (_xgetbv(0) & 0x6) == 0x6;
+
+            if (osAvx && maxLeaf >= 7)
+            {
+                __cpuidex(info.data(), 7, 0);
+                if ((info[1] & (1 << 5)) != 0)
+                {
+                    return swizzleRgbaAvx2;
+                }
+            }
+            if (ssse3)
+            {
+                return swizzleRgbaSsse3;
+            }
+#    elif EXAGE_X86
+            if (__builtin_cpu_supports("avx2"))
+            {
+                return swizzleRgbaAvx2;
+            }
+            if (__builtin_cpu_supports("ssse3"))
+            {
+                return swizzleRgbaSsse3;
+            }
+#    endif
+            return swizzleRgbaScalar;
+        }
+#endif
+
+        // FreeImage keeps 32-bit pixels in the platform's color order, BGRA on little-endian ones
+        void copyRgbaRow(const uint8_t* source, uint8_t* destination, size_t width) noexcept
+        {
+#if FREEIMAGE_COLORORDER == FREEIMAGE_COLORORDER_RGB
+            std::memcpy(destination, source, width * 4);
+#else
+            static RgbaSwizzle const swizzle = selectRgbaSwizzle();
+
+            for (size_t x = swizzle(source, destination, width); x < width; x++)
+            {
+                destination[x * 4] = source[x * 4 + 2];
+                destination[x * 4 + 1] = source[x * 4 + 1];
+                destination[x * 4 + 2] = source[x * 4];
+                destination[x * 4 + 3] = source[x * 4 + 3];
+            }
+#endif
+        }
+
+        constexpr size_t TEXTURE_IMPORT_STEPS = 4;  // Decode, mips, block compression, save
+
+        [[nodiscard]] auto convertTexture(const TextureImport& import,
+                                          ImportProgress& progress) noexcept
+            -> tl::expected<void, Error>
+        {
+            size_t completed = 0;
+            auto advance = [&]
+            {
+                progress.completeStep();
+                completed++;
+                return !progress.isCancelled();
+            };
+
+            // A texture that stops early still counts all of its steps, so the total is reached
+            auto fail = [&](const Error& error) -> tl::expected<void, Error>
+            {
+                for (; completed < TEXTURE_IMPORT_STEPS; completed++)
+                {
+                    progress.completeStep();
+                }
+                return tl::make_unexpected(error);
+            };
+
+            if (progress.isCancelled())
+            {
+                return fail(Errors::Cancelled {});
+            }
+
+            tl::expected<Texture, Error> texture =
+                importTexture(import.sourcePath, MipGenerationOptions {.maxLevels = 1});
+            if (!texture.has_value())
+            {
+                return fail(texture.error());
+            }
+            if (!advance())
+            {
+                return fail(Errors::Cancelled {});
+            }
+
+            tl::expected<void, Error> result = generateMips(*texture, import.mips);
+            if (!result.has_value())
+            {
+                return fail(result.error());
+            }
+            if (!advance())
+            {
+                return fail(Errors::Cancelled {});
+            }
+
+            if (import.compression && texture->bitsPerChannel == 8)
+            {
+                result = compressTexture(*texture, *import.compression);
+                if (!result.has_value())
+                {
+                    return fail(result.error());
+                }
+            }
+            if (!advance())
+            {
+                return fail(Errors::Cancelled {});
+            }
+
+            texture->path = import.path;
+            result = saveTexture(*texture, import.savePath);
+            if (!result.has_value())
+            {
+                return fail(result.error());
+            }
+            advance();
+
+            return {};
+        }
     }  // namespace
 
-    auto importAsset2(const std::filesystem::path& assetPath) noexcept
+    auto importAsset2(const std::filesystem::path& assetPath, ImportProgress* progress) noexcept
         -> tl::expected<AssetImportResult2, Error>
     {
         if (!std::filesystem::exists(assetPath))
@@ -283,11 +490,17 @@ namespace exage::Renderer
             return tl::make_unexpected(Errors::FileNotFound {});
         }
 
+        ImportProgress untracked;
+        ImportProgress& tracked = progress != nullptr ? *progress : untracked;
+
         Assimp::Importer importer;
 
+        // Textures are imported top-down, so v = 0 has to be the top of the image too; assimp
+        // negates the bitangents along with it
         constexpr auto importFlags = static_cast<unsigned int>(
             aiProcess_Triangulate | aiProcess_CalcTangentSpace | aiProcess_JoinIdenticalVertices
-            | aiProcess_GenNormals | aiProcess_GenUVCoords | aiProcess_GenBoundingBoxes);
+            | aiProcess_GenNormals | aiProcess_GenUVCoords | aiProcess_GenBoundingBoxes
+            | aiProcess_FlipUVs);
 
         const auto* scene = importer.ReadFile(assetPath.string(), importFlags);
 
@@ -297,10 +510,17 @@ namespace exage::Renderer
             return tl::make_unexpected(Errors::FileFormat {});
         }
 
-        return processScene2(assetPath, *scene);
+        AssetImportResult2 result = processScene2(assetPath, *scene, tracked);
+        if (tracked.isCancelled())
+        {
+            return tl::make_unexpected(Errors::Cancelled {});
+        }
+
+        return result;
     }
 
-    auto importTexture(const std::filesystem::path& texturePath) noexcept
+    auto importTexture(const std::filesystem::path& texturePath,
+                       const MipGenerationOptions& mipOptions) noexcept
         -> tl::expected<Texture, Error>
     {
         // Load using stb_image or ktx depending on file extension
@@ -660,33 +880,26 @@ namespace exage::Renderer
 
         // Copy the pixel data to the texture
         texture.data = std::vector<std::byte>(size);
-        // std::memcpy(texture.data.data(), FreeImage_GetBits(image), texture.data.size());
 
-        // if type is FIT_BITMAP, don't copy directly, but get each pixel individually since
-        // freeimage stores in either BGRA or RGBA format
-        if (imageType == FIT_BITMAP)
+        // FreeImage stores scanlines bottom-up and padded to 4 bytes, textures top-down and packed.
+        // 8-bit pixels are also swizzled into RGBA order on the way.
+        uint32_t const width = FreeImage_GetWidth(image);
+        uint32_t const height = FreeImage_GetHeight(image);
+        size_t const rowSize = size / height;
+
+        for (uint32_t y = 0; y < height; y++)
         {
-            for (size_t i = 0; i < FreeImage_GetWidth(image); i++)
+            const BYTE* source = FreeImage_GetScanLine(image, static_cast<int>(height - 1 - y));
+            auto* destination = reinterpret_cast<uint8_t*>(texture.data.data()) + y * rowSize;
+
+            if (imageType == FIT_BITMAP)
             {
-                for (size_t j = 0; j < FreeImage_GetHeight(image); j++)
-                {
-                    RGBQUAD color;
-                    FreeImage_GetPixelColor(image, i, j, &color);
-
-                    texture.data[(j * FreeImage_GetWidth(image) + i) * 4] =
-                        static_cast<std::byte>(color.rgbRed);
-                    texture.data[(j * FreeImage_GetWidth(image) + i) * 4 + 1] =
-                        static_cast<std::byte>(color.rgbGreen);
-                    texture.data[(j * FreeImage_GetWidth(image) + i) * 4 + 2] =
-                        static_cast<std::byte>(color.rgbBlue);
-                    texture.data[(j * FreeImage_GetWidth(image) + i) * 4 + 3] =
-                        static_cast<std::byte>(color.rgbReserved);
-                }
+                copyRgbaRow(source, destination, width);
+            }
+            else
+            {
+                std::memcpy(destination, source, rowSize);
             }
-        }
-        else
-        {
-            std::memcpy(texture.data.data(), FreeImage_GetBits(image), texture.data.size());
         }
 
         // Unload the image
@@ -695,6 +908,18 @@ namespace exage::Renderer
         texture.type = Graphics::Texture::Type::e2D;
         texture.layers = 1;
 
+        // The decoded image is already the single level asked for
+        if (mipOptions.maxLevels == 1)
+        {
+            return texture;
+        }
+
+        tl::expected<void, Error> mips = generateMips(texture, mipOptions);
+        if (!mips.has_value())
+        {
+            return tl::make_unexpected(mips.error());
+        }
+
         return texture;
     }
 
@@ -709,6 +934,10 @@ namespace exage::Renderer
         json["bitsPerChannel"] = texture.bitsPerChannel;
         json["layers"] = texture.layers;
         json["type"] = static_cast<uint32_t>(texture.type);
+        if (texture.compressedFormat)
+        {
+            json["compressedFormat"] = static_cast<uint32_t>(*texture.compressedFormat);
+        }
         json["mips"] = nlohmann::json::array();
         json["rawSize"] = texture.data.size();
         json["compression"] = "zstd";
@@ -759,6 +988,12 @@ namespace exage::Renderer
             newPixels[i] = fp16_ieee_from_fp32_value(oldPixels[i]);
         }
 
+        for (Texture::Mip& mip : texture.mips)
+        {
+            mip.offset /= 2;
+            mip.size /= 2;
+        }
+
         texture.bitsPerChannel = 16;
         texture.data.resize(texture.data.size() / 2);
     }
@@ -778,6 +1013,75 @@ namespace exage::Renderer
         return {};
     }
 
+    auto makeTextureImports(const AssetImportResult2& asset,
+                            const std::filesystem::path& saveDirectory) noexcept
+        -> std::vector<TextureImport>
+    {
+        std::vector<TextureImport> imports;
+        imports.reserve(asset.textures.size());
+
+        for (const std::filesystem::path& texture : asset.textures)
+        {
+            std::filesystem::path savePath = saveDirectory / texture.filename();
+            savePath.replace_extension(TEXTURE_EXTENSION);
+
+            std::string path = savePath.generic_string();
+            imports.push_back(TextureImport {
+                .sourcePath = texture,
+                .savePath = std::move(savePath),
+                .path = std::move(path),
+            });
+        }
+
+        auto configure = [&](size_t index, bool color, bool normalMap)
+        {
+            if (index == std::numeric_limits<size_t>::max())
+            {
+                return;
+            }
+
+            TextureImport& import = imports[index];
+            import.mips.srgb = color;
+            import.mips.normalMap = normalMap;
+            import.compression->perceptual = color;
+        };
+
+        for (const AssetImportResult2::Material& material : asset.materials)
+        {
+            configure(material.albedoTextureIndex, true, false);
+            configure(material.emissiveTextureIndex, true, false);
+            configure(material.normalTextureIndex, false, true);
+            configure(material.metallicTextureIndex, false, false);
+            configure(material.roughnessTextureIndex, false, false);
+            configure(material.aoTextureIndex, false, false);
+        }
+
+        return imports;
+    }
+
+    auto importTextures(std::span<const TextureImport> textures, ImportProgress* progress) noexcept
+        -> std::vector<tl::expected<void, Error>>
+    {
+        ImportProgress untracked;
+        ImportProgress& tracked = progress != nullptr ? *progress : untracked;
+        tracked.addSteps(textures.size() * TEXTURE_IMPORT_STEPS);
+
+        // One texture per job; mip generation and block compression fork again inside each one
+        std::vector<tl::expected<void, Error>> results(textures.size());
+        JobSystem::getDefault().parallelFor(
+            textures.size(),
+            1,
+            [&](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; i++)
+                {
+                    results[i] = convertTexture(textures[i], tracked);
+                }
+            });
+
+        return results;
+    }
+
     auto saveMaterial(Material& material) noexcept -> AssetFile
     {
         AssetFile assetFile;
@@ -851,10 +1155,15 @@ namespace exage::Renderer
 
         std::vector<char> binary;
 
-        size_t vertexSize = sizeof(StaticMeshVertex) * mesh.vertices.size();
+        bool const full = mesh.vertexFormat == VertexFormat::eFull;
+        const void* vertexData =
+            full ? static_cast<const void*>(mesh.vertices.data()) : mesh.packedVertices.data();
+        size_t vertexSize =
+            full ? sizeof(StaticMeshVertex) * mesh.vertices.size() : mesh.packedVertices.size();
         size_t indexSize = sizeof(uint32_t) * mesh.indices.size();
 
-        json["vertices"] = mesh.vertices.size();
+        json["vertexFormat"] = static_cast<uint32_t>(mesh.vertexFormat);
+        json["vertices"] = vertexSize / getVertexSize(mesh.vertexFormat);
         json["indices"] = mesh.indices.size();
 
         size_t vertexCompressedSize = ZSTD_compressBound(vertexSize);
@@ -863,7 +1172,7 @@ namespace exage::Renderer
 
         vertexCompressedSize = ZSTD_compress(binary.data(),
                                              vertexCompressedSize,
-                                             mesh.vertices.data(),
+                                             vertexData,
                                              vertexSize,
                                              ZSTD_defaultCLevel());
 
@@ -900,32 +1209,125 @@ namespace exage::Renderer
         return {};
     }
 
-    namespace
+    auto savePrefab(const Prefab& prefab) noexcept -> AssetFile
     {
-        void createChildren(const AssetSceneImportInfo& info,
-                            Scene& scene,
-                            Entity parent,
-                            std::span<const size_t> children,
-                            std::span<const AssetImportResult2::Node> nodes)
+        AssetFile assetFile;
+
+        nlohmann::json json;
+        json["dataType"] = "Prefab";
+        json["path"] = prefab.path;
+        json["aabb"] = {
+            {"min", prefab.aabb.min},
+            {"max", prefab.aabb.max},
+        };
+        json["meshes"] = nlohmann::json::array();
+
+        for (size_t i = 0; i < prefab.meshes.size(); i++)
         {
-            for (const auto& child : children)
-            {
-                const auto& node = nodes[child];
-                auto entity = scene.createEntity(parent);
-                scene.addComponent<Transform3D>(entity, node.transform);
+            const PrefabMesh& mesh = prefab.meshes[i];
+            json["meshes"][i]["path"] = getAssetPath(mesh.mesh);
+            json["meshes"][i]["aabb"] = {
+                {"min", mesh.aabb.min},
+                {"max", mesh.aabb.max},
+            };
+        }
 
-                GPUStaticMesh& mesh = info.meshes[node.meshIndex];
-                StaticMeshComponent meshComponent = {.path = mesh.path, .pathHash = mesh.pathHash};
-                scene.addComponent<StaticMeshComponent>(entity, meshComponent);
+        // Nodes are plain data, stored as is
+        json["nodes"] = prefab.nodes.size();
 
-                createChildren(info, scene, entity, node.childrenIndices, nodes);
-            }
+        size_t nodeSize = prefab.nodes.size() * sizeof(Prefab::Node);
+        assetFile.binary.resize(nodeSize);
+        std::memcpy(assetFile.binary.data(), prefab.nodes.data(), nodeSize);
+
+        assetFile.json = json.dump();
+
+        return assetFile;
+    }
+
+    auto savePrefab(const Prefab& prefab, const std::filesystem::path& savePath) noexcept
+        -> tl::expected<void, Error>
+    {
+        std::ofstream prefabFile(savePath, std::ios::binary);
+        if (!prefabFile.is_open())
+        {
+            return tl::make_unexpected(Errors::FileNotFound {});
         }
-    }  // namespace
+
+        AssetFile assetFile = savePrefab(prefab);
+        saveAssetFile(prefabFile, assetFile);
+
+        return {};
+    }
 
     void importScene(const AssetSceneImportInfo& info, Scene& scene, Entity parent) noexcept
     {
-        createChildren(info, scene, parent, info.rootNodes, info.nodes);
+        // Nodes are stored depth-first, so every parent index precedes its children
+        ScenePrefab prefab;
+        prefab.parents.reserve(info.nodes.size());
+        prefab.transforms.reserve(info.nodes.size());
+
+        std::vector<StaticMeshComponent> meshComponents;
+        meshComponents.reserve(info.nodes.size());
+
+        for (const auto& node : info.nodes)
+        {
+            prefab.parents.push_back(node.parentIndex);
+            prefab.transforms.push_back(node.transform);
+
+            GPUStaticMesh& mesh = info.meshes[node.meshIndex];
+            meshComponents.push_back({.mesh = mesh.handle});
+        }
+
+        std::vector<Entity> entities = scene.instantiate(prefab, parent);
+        scene.addComponents<StaticMeshComponent>(entities, meshComponents.begin());
+    }
+
+    auto makePrefab(const AssetSceneImportInfo& info, std::string path) noexcept -> Prefab
+    {
+        Prefab prefab;
+        prefab.handle = internAsset(path);
+        prefab.path = std::move(path);
+        prefab.nodes.reserve(info.nodes.size());
+
+        // Prefab mesh of each imported mesh, only for the ones that are used
+        constexpr uint32_t NO_MESH = std::numeric_limits<uint32_t>::max();
+        std::vector<uint32_t> meshIndices(info.meshes.size(), NO_MESH);
+
+        // Nodes are stored depth-first, so every parent's matrix is known before its children
+        for (const auto& node : info.nodes)
+        {
+            Prefab::Node& prefabNode = prefab.nodes.emplace_back();
+            prefabNode.matrix = calculateTransformMatrix(node.transform);
+
+            if (node.parentIndex != ScenePrefab::NO_PARENT)
+            {
+                prefabNode.parent = static_cast<uint32_t>(node.parentIndex);
+                prefabNode.matrix = prefab.nodes[node.parentIndex].matrix * prefabNode.matrix;
+            }
+
+            uint32_t& meshIndex = meshIndices[node.meshIndex];
+            if (meshIndex == NO_MESH)
+            {
+                const GPUStaticMesh& mesh = info.meshes[node.meshIndex];
+                meshIndex = static_cast<uint32_t>(prefab.meshes.size());
+                prefab.meshes.push_back({mesh.handle, mesh.aabb});
+            }
+            prefabNode.mesh = meshIndex;
+        }
+
+        prefab.aabb = calculatePrefabBounds(prefab);
+        return prefab;
+    }
+
+    auto placePrefab(const Prefab& prefab,
+                     Scene& scene,
+                     const Transform3D& transform,
+                     Entity parent) noexcept -> Entity
+    {
+        Entity entity = scene.createEntity(parent);
+        scene.addComponent<Transform3D>(entity, transform);
+        scene.addComponent<PrefabInstance>(entity, PrefabInstance {.prefab = prefab.handle});
+        return entity;
     }
 
 }  // namespace exage::Renderer
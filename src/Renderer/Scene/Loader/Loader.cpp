@@ -1,11 +1,11 @@
-﻿#include <fstream>
+﻿#include <cstring>
+#include <fstream>
 #include <unordered_set>
 
 #include "exage/Renderer/Scene/Loader/Loader.h"
 
 #include <exage/utils/serialization.h>
 
-#include "bc7enc.h"
 #include "exage/Core/Debug.h"
 #include "exage/Core/Errors.h"
 #include "exage/Graphics/Buffer.h"
@@ -13,6 +13,7 @@
 #include "exage/Renderer/Scene/Loader/AssetFile.h"
 #include "exage/Renderer/Scene/Material.h"
 #include "exage/Renderer/Scene/Mesh.h"
+#include "exage/Renderer/Scene/VertexPacking.h"
 #include "zstd.h"
 
 namespace exage::Renderer
@@ -94,77 +95,6 @@ namespace exage::Renderer
             debugAssume(false, "Invalid format");  // Should have been handled by the converter
             return Graphics::Format::eRGBA8;
         }
-
-        [[nodiscard]] auto getCompressedFormat(
-            uint8_t channels,
-            uint8_t bitsPerChannel,
-            const std::unordered_set<Graphics::Format>& compressedTextureSupport)
-            -> Graphics::Format
-        {
-            // Priority order: ASTC > BC > ETC2
-
-            if (bitsPerChannel != 8)
-            {
-                return getUncompressedFormat(channels, bitsPerChannel);
-            }
-
-            switch (channels)
-            {
-                case 1:
-                {
-                    if (compressedTextureSupport.contains(Graphics::Format::eBC4R8))
-                    {
-                        return Graphics::Format::eBC4R8;
-                    }
-                }
-
-                case 2:
-                {
-                    if (compressedTextureSupport.contains(Graphics::Format::eBC5RG8))
-                    {
-                        return Graphics::Format::eBC5RG8;
-                    }
-                }
-
-                case 4:
-                {
-                    if (compressedTextureSupport.contains(Graphics::Format::eASTC6x6RGBA8))
-                    {
-                        return Graphics::Format::eASTC6x6RGBA8;
-                    }
-
-                    if (compressedTextureSupport.contains(Graphics::Format::eASTC4x4RGBA8))
-                    {
-                        return Graphics::Format::eASTC4x4RGBA8;
-                    }
-
-                    if (compressedTextureSupport.contains(Graphics::Format::eBC7RGBA8))
-                    {
-                        return Graphics::Format::eBC7RGBA8;
-                    }
-
-                    if (compressedTextureSupport.contains(Graphics::Format::eBC3RGBA8))
-                    {
-                        return Graphics::Format::eBC3RGBA8;
-                    }
-
-                    if (compressedTextureSupport.contains(Graphics::Format::eBC1RGBA8))
-                    {
-                        return Graphics::Format::eBC1RGBA8;
-                    }
-
-                    if (compressedTextureSupport.contains(Graphics::Format::eETC2RGBA8))
-                    {
-                        return Graphics::Format::eETC2RGBA8;
-                    }
-                }
-
-                default:
-                    break;
-            }
-
-            return getUncompressedFormat(channels, bitsPerChannel);
-        }
     }  // namespace
 
     auto queryCompressedTextureSupport(Graphics::Context& context) noexcept
@@ -227,6 +157,11 @@ namespace exage::Renderer
         texture.type = static_cast<Graphics::Texture::Type>(json["type"]);
         texture.layers = json["layers"];
 
+        if (json.contains("compressedFormat"))
+        {
+            texture.compressedFormat = static_cast<Graphics::Format>(json["compressedFormat"]);
+        }
+
         size_t decompressedSize = json["rawSize"];
         texture.data.resize(decompressedSize);
 
@@ -318,11 +253,30 @@ namespace exage::Renderer
         size_t vertexCompressedSize = json["vertexCompressedSize"];
         size_t indexCompressedSize = json["indexCompressedSize"];
 
-        mesh.vertices.resize(vertices);
+        // Meshes saved before the packed formats existed have no vertexFormat
+        uint32_t const vertexFormat = json.value("vertexFormat", 0U);
+        if (vertexFormat > static_cast<uint32_t>(VertexFormat::eQuantized))
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+        mesh.vertexFormat = static_cast<VertexFormat>(vertexFormat);
+
+        void* vertexData = nullptr;
+        size_t const vertexSize = vertices * getVertexSize(mesh.vertexFormat);
+        if (mesh.vertexFormat == VertexFormat::eFull)
+        {
+            mesh.vertices.resize(vertices);
+            vertexData = mesh.vertices.data();
+        }
+        else
+        {
+            mesh.packedVertices.resize(vertexSize);
+            vertexData = mesh.packedVertices.data();
+        }
         mesh.indices.resize(indices);
 
-        size_t result = ZSTD_decompress(mesh.vertices.data(),
-                                        mesh.vertices.size() * sizeof(StaticMeshVertex),
+        size_t result = ZSTD_decompress(vertexData,
+                                        vertexSize,
                                         asset->binary.data(),
                                         vertexCompressedSize);
 
@@ -344,13 +298,77 @@ namespace exage::Renderer
         return mesh;
     }
 
+    auto loadPrefab(const std::filesystem::path& path) noexcept -> tl::expected<Prefab, Error>
+    {
+        tl::expected asset = loadAssetFile(path);
+
+        if (!asset.has_value())
+        {
+            return tl::make_unexpected(asset.error());
+        }
+
+        nlohmann::json json = nlohmann::json::parse(asset->json);
+
+        if (json["dataType"] != "Prefab")
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+
+        Prefab prefab;
+        prefab.path = json["path"].get<std::string>();
+        prefab.handle = internAsset(prefab.path);
+        prefab.aabb.max = json["aabb"]["max"];
+        prefab.aabb.min = json["aabb"]["min"];
+
+        for (const auto& mesh : json["meshes"])
+        {
+            PrefabMesh& prefabMesh = prefab.meshes.emplace_back();
+            prefabMesh.mesh = internAsset(mesh["path"].get<std::string>());
+            prefabMesh.aabb.max = mesh["aabb"]["max"];
+            prefabMesh.aabb.min = mesh["aabb"]["min"];
+        }
+
+        size_t nodes = json["nodes"];
+        if (asset->binary.size() != nodes * sizeof(Prefab::Node))
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+
+        prefab.nodes.resize(nodes);
+        std::memcpy(prefab.nodes.data(), asset->binary.data(), asset->binary.size());
+
+        for (const Prefab::Node& node : prefab.nodes)
+        {
+            if (node.mesh >= prefab.meshes.size())
+            {
+                return tl::make_unexpected(Errors::FileFormat {});
+            }
+        }
+
+        return prefab;
+    }
+
     auto uploadTexture(const Texture& texture, const TextureUploadOptions& options) noexcept
-        -> GPUTexture
+        -> tl::expected<GPUTexture, Error>
     {
         debugAssume(!texture.mips.empty(), "Texture must have at least one mip level");
 
+        // Block-compressed data is uploaded as is; everything else keeps its channel layout
+        if (texture.compressedFormat)
+        {
+            bool const supported = options.supportedCompressedFormats != nullptr
+                ? options.supportedCompressedFormats->contains(*texture.compressedFormat)
+                : options.context.getFormatSupport(*texture.compressedFormat).first;
+
+            if (!supported)
+            {
+                return tl::make_unexpected(Errors::UnsupportedFormat {});
+            }
+        }
+
         GPUTexture gpuTexture;
         gpuTexture.path = texture.path;
+        gpuTexture.handle = internAsset(texture.path);
 
         std::shared_ptr<Graphics::Buffer> stagingBuffer;
 
@@ -364,25 +382,10 @@ namespace exage::Renderer
 
         stagingBuffer->write(data, 0);
 
-        std::unordered_set<Graphics::Format>* supportedCompressedFormatsPtr =
-            options.supportedCompressedFormats;
-
-        std::optional<std::unordered_set<Graphics::Format>> supportedCompressedFormats =
-            std::nullopt;
-        if (options.useCompressedFormat)
-        {
-            if (supportedCompressedFormatsPtr == nullptr)
-            {
-                supportedCompressedFormats = queryCompressedTextureSupport(options.context);
-                supportedCompressedFormatsPtr = &*supportedCompressedFormats;
-            }
-        }
-
         Graphics::TextureCreateInfo textureCreateInfo;
         textureCreateInfo.extent = texture.mips[0].extent;
-        textureCreateInfo.format = options.useCompressedFormat
-            ? getCompressedFormat(
-                texture.channels, texture.bitsPerChannel, *supportedCompressedFormatsPtr)
+        textureCreateInfo.format = texture.compressedFormat
+            ? *texture.compressedFormat
             : getUncompressedFormat(texture.channels, texture.bitsPerChannel);
         textureCreateInfo.usage = options.usage;  // Graphics::Texture::UsageFlags::eSampled |
         // Graphics::Texture::UsageFlags::eTransferDst;
@@ -435,9 +438,7 @@ namespace exage::Renderer
     //    {
     //        GPUStaticMesh gpuMesh;
     //        gpuMesh.path = mesh.path;
-    //
-    //        std::hash<std::string> hasher;
-    //        gpuMesh.pathHash = hasher(mesh.path);
+    //        gpuMesh.handle = internAsset(mesh.path);
     //        gpuMesh.materialPath = mesh.materialPath;
     //        gpuMesh.aabb = mesh.aabb;
     //
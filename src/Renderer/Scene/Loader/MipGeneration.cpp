@@ -0,0 +1,518 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstring>
+#include <numbers>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "exage/Renderer/Scene/Loader/MipGeneration.h"
+
+#include <fp16.h>
+
+#include "Core/SimdLanes.h"
+#include "exage/Core/Debug.h"
+#include "exage/Core/JobSystem.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        constexpr float WINDOWED_RADIUS = 3.F;  // Of the Kaiser and Lanczos filters
+        constexpr float KAISER_ALPHA = 4.F;
+        constexpr size_t MIN_ROWS_PER_JOB = 4;
+
+        auto sinc(float x) noexcept -> float
+        {
+            if (std::abs(x) < 1e-5F)
+            {
+                return 1.F;
+            }
+
+            float const angle = std::numbers::pi_v<float> * x;
+            return std::sin(angle) / angle;
+        }
+
+        // Modified Bessel function of the first kind and order zero, by its power series
+        auto bessel0(float x) noexcept -> float
+        {
+            float const quarterSquare = x * x / 4.F;
+            float sum = 1.F;
+            float term = 1.F;
+            for (int k = 1; k < 32 && term > sum * 1e-7F; k++)
+            {
+                term *= quarterSquare / static_cast<float>(k * k);
+                sum += term;
+            }
+            return sum;
+        }
+
+        auto getRadius(MipFilter filter) noexcept -> float
+        {
+            return filter == MipFilter::eBox ? 0.5F : WINDOWED_RADIUS;
+        }
+
+        // At a distance of x texels of the smaller level
+        auto getWeight(MipFilter filter, float x) noexcept -> float
+        {
+            switch (filter)
+            {
+                case MipFilter::eBox:
+                    return std::abs(x) <= 0.5F ? 1.F : 0.F;
+                case MipFilter::eKaiser:
+                {
+                    float const ratio = x / WINDOWED_RADIUS;
+                    if (std::abs(ratio) >= 1.F)
+                    {
+                        return 0.F;
+                    }
+                    return sinc(x) * bessel0(KAISER_ALPHA * std::sqrt(1.F - ratio * ratio))
+                        / bessel0(KAISER_ALPHA);
+                }
+                case MipFilter::eLanczos:
+                    return std::abs(x) < WINDOWED_RADIUS ? sinc(x) * sinc(x / WINDOWED_RADIUS)
+                                                         : 0.F;
+            }
+            return 0.F;
+        }
+
+        struct Tap
+        {
+            uint32_t source;
+            float weight;
+        };
+
+        // For every texel along one axis of the smaller level, the texels it is filtered from
+        struct Taps
+        {
+            std::vector<uint32_t> starts;  // Into taps, with one past the end last
+            std::vector<Tap> taps;
+
+            [[nodiscard]] auto get(size_t i) const noexcept -> std::span<const Tap>
+            {
+                return {taps.data() + starts[i], taps.data() + starts[i + 1]};
+            }
+        };
+
+        auto makeTaps(MipFilter filter, uint32_t sourceSize, uint32_t size) noexcept -> Taps
+        {
+            float const scale = static_cast<float>(sourceSize) / static_cast<float>(size);
+            float const support = getRadius(filter) * scale;
+
+            Taps result;
+            result.starts.reserve(size + 1);
+
+            for (uint32_t i = 0; i < size; i++)
+            {
+                auto const start = static_cast<uint32_t>(result.taps.size());
+                result.starts.push_back(start);
+
+                float const center = (static_cast<float>(i) + 0.5F) * scale;
+                auto const first = static_cast<int64_t>(std::floor(center - support));
+                auto const last = static_cast<int64_t>(std::ceil(center + support));
+
+                float sum = 0.F;
+                for (int64_t s = first; s <= last; s++)
+                {
+                    float const weight =
+                        getWeight(filter, (static_cast<float>(s) + 0.5F - center) / scale);
+                    if (weight == 0.F)
+                    {
+                        continue;
+                    }
+
+                    // Edges are clamped, so taps past them fold onto the outermost texel
+                    auto const source = static_cast<uint32_t>(
+                        std::clamp<int64_t>(s, 0, static_cast<int64_t>(sourceSize) - 1));
+                    if (result.taps.size() > start && result.taps.back().source == source)
+                    {
+                        result.taps.back().weight += weight;
+                    }
+                    else
+                    {
+                        result.taps.push_back({source, weight});
+                    }
+                    sum += weight;
+                }
+
+                debugAssume(sum > 0.F, "Every texel must be covered by the filter");
+                for (size_t t = start; t < result.taps.size(); t++)
+                {
+                    result.taps[t].weight /= sum;
+                }
+            }
+
+            result.starts.push_back(static_cast<uint32_t>(result.taps.size()));
+            return result;
+        }
+
+#if EXAGE_SIMD
+        constexpr size_t CHUNK_FLOATS = detail::LANE_COUNT;
+#else
+        constexpr size_t CHUNK_FLOATS = 1;
+#endif
+
+        // The floats of one vector, aligned for loadLanes
+        struct alignas(CHUNK_FLOATS * sizeof(float)) Chunk
+        {
+            std::array<float, CHUNK_FLOATS> values;
+        };
+
+        // One slice of a level, in float; rows are padded to whole vectors, with zeros
+        class Image
+        {
+          public:
+            Image(uint32_t width, uint32_t height, uint8_t channels) noexcept
+                : _width(width)
+                , _height(height)
+                , _stride((static_cast<size_t>(width) * channels + CHUNK_FLOATS - 1)
+                          / CHUNK_FLOATS * CHUNK_FLOATS)
+                , _chunks(_stride / CHUNK_FLOATS * height)
+            {
+            }
+
+            [[nodiscard]] auto getWidth() const noexcept -> uint32_t { return _width; }
+            [[nodiscard]] auto getHeight() const noexcept -> uint32_t { return _height; }
+            [[nodiscard]] auto getStride() const noexcept -> size_t { return _stride; }
+
+            [[nodiscard]] auto getRow(size_t y) noexcept -> float*
+            {
+                return reinterpret_cast<float*>(_chunks.data()) + y * _stride;
+            }
+            [[nodiscard]] auto getRow(size_t y) const noexcept -> const float*
+            {
+                return reinterpret_cast<const float*>(_chunks.data()) + y * _stride;
+            }
+
+          private:
+            uint32_t _width;
+            uint32_t _height;
+            size_t _stride;  // In floats
+            std::vector<Chunk> _chunks;
+        };
+
+        // destination += weight * source, over count floats, a multiple of CHUNK_FLOATS
+        void accumulate(float* destination, const float* source, float weight, size_t count)
+        {
+#if EXAGE_SIMD
+            using namespace detail;
+
+            Lanes const weights = splat(weight);
+            for (size_t i = 0; i < count; i += LANE_COUNT)
+            {
+                storeLanes(destination + i,
+                           add(loadLanes(destination + i), mul(weights, loadLanes(source + i))));
+            }
+#else
+            for (size_t i = 0; i < count; i++)
+            {
+                destination[i] += weight * source[i];
+            }
+#endif
+        }
+
+        auto getSrgbToLinear() noexcept -> const std::array<float, 256>&
+        {
+            static const std::array<float, 256> table = []
+            {
+                std::array<float, 256> values {};
+                for (size_t i = 0; i < values.size(); i++)
+                {
+                    float const value = static_cast<float>(i) / 255.F;
+                    values[i] = value <= 0.04045F ? value / 12.92F
+                                                  : std::pow((value + 0.055F) / 1.055F, 2.4F);
+                }
+                return values;
+            }();
+            return table;
+        }
+
+        auto linearToSrgb(float value) noexcept -> float
+        {
+            return value <= 0.0031308F ? value * 12.92F
+                                       : 1.055F * std::pow(value, 1.F / 2.4F) - 0.055F;
+        }
+
+        // How the texels of a texture are stored, and which channels need more than a load
+        struct Encoding
+        {
+            uint8_t channels;
+            uint8_t bitsPerChannel;
+            uint8_t srgbChannels;
+            uint8_t normalChannels;
+            bool signedNormals;  // Normals are stored as is instead of mapped to [0, 1]
+
+            [[nodiscard]] auto getTexelSize() const noexcept -> size_t
+            {
+                return static_cast<size_t>(channels) * bitsPerChannel / 8;
+            }
+        };
+
+        void decodeRow(const Encoding& encoding, const std::byte* source, float* row, size_t width)
+        {
+            size_t const count = width * encoding.channels;
+            switch (encoding.bitsPerChannel)
+            {
+                case 8:
+                {
+                    const std::array<float, 256>& srgbToLinear = getSrgbToLinear();
+                    const auto* values = reinterpret_cast<const uint8_t*>(source);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        size_t const channel = i % encoding.channels;
+                        row[i] = channel < encoding.srgbChannels
+                            ? srgbToLinear[values[i]]
+                            : static_cast<float>(values[i]) / 255.F;
+                    }
+                    break;
+                }
+                case 16:
+                {
+                    const auto* values = reinterpret_cast<const uint16_t*>(source);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        row[i] = fp16_ieee_to_fp32_value(values[i]);
+                    }
+                    break;
+                }
+                default:
+                    std::memcpy(row, source, count * sizeof(float));
+                    break;
+            }
+
+            if (encoding.normalChannels > 0 && !encoding.signedNormals)
+            {
+                for (size_t i = 0; i < count; i++)
+                {
+                    if (i % encoding.channels < encoding.normalChannels)
+                    {
+                        row[i] = row[i] * 2.F - 1.F;
+                    }
+                }
+            }
+        }
+
+        void encodeRow(const Encoding& encoding,
+                       const float* row,
+                       std::byte* destination,
+                       size_t width)
+        {
+            size_t const count = width * encoding.channels;
+            switch (encoding.bitsPerChannel)
+            {
+                case 8:
+                {
+                    auto* values = reinterpret_cast<uint8_t*>(destination);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        size_t const channel = i % encoding.channels;
+                        float value = row[i];
+                        if (channel < encoding.normalChannels)
+                        {
+                            value = value * 0.5F + 0.5F;
+                        }
+                        else if (channel < encoding.srgbChannels)
+                        {
+                            value = linearToSrgb(std::max(value, 0.F));
+                        }
+                        values[i] =
+                            static_cast<uint8_t>(std::lround(std::clamp(value, 0.F, 1.F) * 255.F));
+                    }
+                    break;
+                }
+                case 16:
+                {
+                    auto* values = reinterpret_cast<uint16_t*>(destination);
+                    for (size_t i = 0; i < count; i++)
+                    {
+                        values[i] = fp16_ieee_from_fp32_value(row[i]);
+                    }
+                    break;
+                }
+                default:
+                    std::memcpy(destination, row, count * sizeof(float));
+                    break;
+            }
+        }
+
+        void renormalize(float* texel, uint8_t normalChannels) noexcept
+        {
+            if (normalChannels >= 3)
+            {
+                float const length =
+                    std::sqrt(texel[0] * texel[0] + texel[1] * texel[1] + texel[2] * texel[2]);
+                if (length > 0.F)
+                {
+                    texel[0] /= length;
+                    texel[1] /= length;
+                    texel[2] /= length;
+                }
+                else
+                {
+                    texel[0] = 0.F;
+                    texel[1] = 0.F;
+                    texel[2] = 1.F;
+                }
+            }
+            else if (normalChannels == 2)
+            {
+                // z is reconstructed from x and y, which must stay within the unit circle for that
+                float const length = std::sqrt(texel[0] * texel[0] + texel[1] * texel[1]);
+                if (length > 1.F)
+                {
+                    texel[0] /= length;
+                    texel[1] /= length;
+                }
+            }
+        }
+
+        /* Filters a level down to the next, both in float, and encodes the result into
+         * destination. Each destination row is first filtered vertically, accumulating whole source
+         * rows at once, then horizontally. */
+        void downsample(const Encoding& encoding,
+                        const Image& source,
+                        const Taps& rows,
+                        const Taps& columns,
+                        Image& destination,
+                        std::byte* encoded)
+        {
+            size_t const encodedRowSize = destination.getWidth() * encoding.getTexelSize();
+            uint8_t const channels = encoding.channels;
+
+            JobSystem::getDefault().parallelFor(
+                destination.getHeight(),
+                MIN_ROWS_PER_JOB,
+                [&](size_t first, size_t last)
+                {
+                    Image filtered {source.getWidth(), 1, channels};
+                    float* const filteredRow = filtered.getRow(0);
+
+                    for (size_t y = first; y < last; y++)
+                    {
+                        std::fill_n(filteredRow, filtered.getStride(), 0.F);
+                        for (const Tap& tap : rows.get(y))
+                        {
+                            accumulate(filteredRow,
+                                       source.getRow(tap.source),
+                                       tap.weight,
+                                       source.getStride());
+                        }
+
+                        float* const row = destination.getRow(y);
+                        for (uint32_t x = 0; x < destination.getWidth(); x++)
+                        {
+                            float* const texel = row + static_cast<size_t>(x) * channels;
+                            for (const Tap& tap : columns.get(x))
+                            {
+                                const float* input =
+                                    filteredRow + static_cast<size_t>(tap.source) * channels;
+                                for (uint8_t c = 0; c < channels; c++)
+                                {
+                                    texel[c] += tap.weight * input[c];
+                                }
+                            }
+                            renormalize(texel, encoding.normalChannels);
+                        }
+
+                        encodeRow(encoding,
+                                  row,
+                                  encoded + y * encodedRowSize,
+                                  destination.getWidth());
+                    }
+                });
+        }
+    }  // namespace
+
+    auto generateMips(Texture& texture, const MipGenerationOptions& options) noexcept
+        -> tl::expected<void, Error>
+    {
+        debugAssume(!(options.srgb && options.normalMap),
+                    "Normal maps hold vectors, not sRGB-encoded color");
+
+        bool const supportedBits = texture.bitsPerChannel == 8 || texture.bitsPerChannel == 16
+            || texture.bitsPerChannel == 32;
+        if (texture.compressedFormat || texture.type == Graphics::Texture::Type::e3D
+            || texture.mips.empty() || texture.channels == 0 || !supportedBits)
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+
+        uint8_t const colorChannels = std::min<uint8_t>(texture.channels, 3);
+        Encoding const encoding {
+            texture.channels,
+            texture.bitsPerChannel,
+            options.srgb && texture.bitsPerChannel == 8 ? colorChannels : uint8_t {0},
+            options.normalMap && texture.channels >= 2 ? colorChannels : uint8_t {0},
+            texture.bitsPerChannel != 8,
+        };
+
+        const Texture::Mip base = texture.mips[0];
+        size_t const texelSize = encoding.getTexelSize();
+        size_t const sliceSize = static_cast<size_t>(base.extent.x) * base.extent.y * texelSize;
+        if (sliceSize == 0 || base.size % sliceSize != 0
+            || base.offset + base.size > texture.data.size())
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+        size_t const sliceCount = base.size / sliceSize;
+
+        // Levels laid out one after the other, each with all of its slices
+        std::vector<Texture::Mip> mips {{base.extent, 0, base.size}};
+        uint32_t const maxLevels = options.maxLevels == 0 ? UINT32_MAX : options.maxLevels;
+        while (mips.size() < maxLevels
+               && (mips.back().extent.x > 1 || mips.back().extent.y > 1))
+        {
+            const Texture::Mip& previous = mips.back();
+            glm::uvec3 const extent {std::max(previous.extent.x / 2, 1U),
+                                     std::max(previous.extent.y / 2, 1U),
+                                     1};
+            size_t const size = static_cast<size_t>(extent.x) * extent.y * texelSize * sliceCount;
+            mips.push_back({extent, previous.offset + previous.size, size});
+        }
+
+        // Rows, then columns, of each level after the first
+        std::vector<std::pair<Taps, Taps>> taps;
+        for (size_t i = 1; i < mips.size(); i++)
+        {
+            taps.emplace_back(makeTaps(options.filter, mips[i - 1].extent.y, mips[i].extent.y),
+                              makeTaps(options.filter, mips[i - 1].extent.x, mips[i].extent.x));
+        }
+
+        std::vector<std::byte> data(mips.back().offset + mips.back().size);
+        std::memcpy(data.data(), texture.data.data() + base.offset, base.size);
+
+        for (size_t s = 0; s < sliceCount; s++)
+        {
+            Image current {base.extent.x, base.extent.y, texture.channels};
+            const std::byte* source = texture.data.data() + base.offset + s * sliceSize;
+            for (uint32_t y = 0; y < base.extent.y; y++)
+            {
+                decodeRow(encoding,
+                          source + static_cast<size_t>(y) * base.extent.x * texelSize,
+                          current.getRow(y),
+                          base.extent.x);
+            }
+
+            for (size_t i = 1; i < mips.size(); i++)
+            {
+                const Texture::Mip& mip = mips[i];
+                size_t const levelSliceSize = mip.size / sliceCount;
+
+                Image next {mip.extent.x, mip.extent.y, texture.channels};
+                downsample(encoding,
+                           current,
+                           taps[i - 1].first,
+                           taps[i - 1].second,
+                           next,
+                           data.data() + mip.offset + s * levelSliceSize);
+                current = std::move(next);
+            }
+        }
+
+        texture.data = std::move(data);
+        texture.mips = std::move(mips);
+
+        return {};
+    }
+}  // namespace exage::Renderer
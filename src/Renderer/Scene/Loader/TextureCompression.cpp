@@ -0,0 +1,396 @@
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <mutex>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "exage/Renderer/Scene/Loader/TextureCompression.h"
+
+#include "bc7enc.h"
+#include "exage/Core/Debug.h"
+#include "exage/Core/JobSystem.h"
+#include "rgbcx.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        constexpr uint32_t BLOCK_DIMENSION = 4;
+        constexpr size_t BLOCK_TEXELS = BLOCK_DIMENSION * BLOCK_DIMENSION;
+        constexpr size_t HALF_BLOCK_SIZE = 8;  // A BC1 or BC4 block
+
+        using BlockTexels = std::array<uint8_t, BLOCK_TEXELS * 4>;  // RGBA, R first
+
+        // The 8-byte parts of BC1 to BC5 blocks, which rate-distortion optimization works on
+        struct HalfBlock
+        {
+            bool color;  // BC1 over RGB, otherwise BC4 over a single channel
+            uint32_t channel;
+        };
+
+        struct BlockLayout
+        {
+            uint8_t channels;  // Of the source texture
+            size_t blockSize;
+            std::array<HalfBlock, 2> halves;
+            size_t halfCount;  // 0 for BC7, which is encoded whole
+        };
+
+        auto getBlockLayout(Graphics::Format format) noexcept -> std::optional<BlockLayout>
+        {
+            switch (format)
+            {
+                case Graphics::Format::eBC1RGBA8:
+                    return BlockLayout {4, 8, {HalfBlock {true, 0}}, 1};
+                case Graphics::Format::eBC3RGBA8:
+                    return BlockLayout {4, 16, {HalfBlock {false, 3}, HalfBlock {true, 0}}, 2};
+                case Graphics::Format::eBC4R8:
+                    return BlockLayout {1, 8, {HalfBlock {false, 0}}, 1};
+                case Graphics::Format::eBC5RG8:
+                    return BlockLayout {2, 16, {HalfBlock {false, 0}, HalfBlock {false, 1}}, 2};
+                case Graphics::Format::eBC7RGBA8:
+                    return BlockLayout {4, 16, {}, 0};
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        auto getDefaultFormat(uint8_t channels) noexcept -> std::optional<Graphics::Format>
+        {
+            switch (channels)
+            {
+                case 1:
+                    return Graphics::Format::eBC4R8;
+                case 2:
+                    return Graphics::Format::eBC5RG8;
+                case 4:
+                    return Graphics::Format::eBC7RGBA8;
+                default:
+                    return std::nullopt;
+            }
+        }
+
+        void initializeEncoders() noexcept
+        {
+            static std::once_flag once;
+            std::call_once(once,
+                           []
+                           {
+                               rgbcx::init();
+                               bc7enc_compress_block_init();
+                           });
+        }
+
+        struct Encoder
+        {
+            BlockLayout layout;
+            uint32_t bc1Level;
+            bool bc4HighQuality;
+            bc7enc_compress_block_params bc7Params;
+            float rdoTolerance;
+            uint32_t rdoWindow;
+        };
+
+        auto makeEncoder(const BlockLayout& layout, const BlockCompressionOptions& options) noexcept
+            -> Encoder
+        {
+            Encoder encoder {};
+            encoder.layout = layout;
+            encoder.rdoTolerance = options.rdoTolerance;
+            encoder.rdoWindow = options.rdoWindow;
+
+            bc7enc_compress_block_params_init(&encoder.bc7Params);
+            if (!options.perceptual)
+            {
+                bc7enc_compress_block_params_init_linear_weights(&encoder.bc7Params);
+            }
+
+            switch (options.quality)
+            {
+                case BlockCompressionQuality::eFast:
+                    encoder.bc1Level = 2;
+                    encoder.bc4HighQuality = false;
+                    encoder.bc7Params.m_uber_level = 0;
+                    encoder.bc7Params.m_max_partitions = 0;
+                    break;
+                case BlockCompressionQuality::eNormal:
+                    encoder.bc1Level = 10;
+                    encoder.bc4HighQuality = true;
+                    encoder.bc7Params.m_uber_level = 1;
+                    break;
+                case BlockCompressionQuality::eHigh:
+                    encoder.bc1Level = rgbcx::MAX_LEVEL;
+                    encoder.bc4HighQuality = true;
+                    encoder.bc7Params.m_uber_level = BC7ENC_MAX_UBER_LEVEL;
+                    break;
+            }
+
+            return encoder;
+        }
+
+        // Clamps to the edge of the slice; missing channels are 0, and alpha 255
+        void loadBlock(const uint8_t* slice,
+                       glm::uvec2 extent,
+                       uint8_t channels,
+                       uint32_t blockX,
+                       uint32_t blockY,
+                       BlockTexels& texels) noexcept
+        {
+            for (uint32_t y = 0; y < BLOCK_DIMENSION; y++)
+            {
+                uint32_t const sourceY = std::min(blockY * BLOCK_DIMENSION + y, extent.y - 1);
+                for (uint32_t x = 0; x < BLOCK_DIMENSION; x++)
+                {
+                    uint32_t const sourceX = std::min(blockX * BLOCK_DIMENSION + x, extent.x - 1);
+                    const uint8_t* source =
+                        slice + (static_cast<size_t>(sourceY) * extent.x + sourceX) * channels;
+
+                    uint8_t* texel = texels.data() + (y * BLOCK_DIMENSION + x) * 4;
+                    texel[0] = source[0];
+                    texel[1] = channels > 1 ? source[1] : 0;
+                    texel[2] = channels > 2 ? source[2] : 0;
+                    texel[3] = channels > 3 ? source[3] : 255;
+                }
+            }
+        }
+
+        void encodeHalf(const Encoder& encoder,
+                        const HalfBlock& half,
+                        const BlockTexels& texels,
+                        uint8_t* destination) noexcept
+        {
+            if (half.color)
+            {
+                // No 3-color blocks: their fourth selector would sample as transparent black
+                rgbcx::encode_bc1(encoder.bc1Level, destination, texels.data(), false, false);
+            }
+            else if (encoder.bc4HighQuality)
+            {
+                rgbcx::encode_bc4_hq(destination, texels.data() + half.channel);
+            }
+            else
+            {
+                rgbcx::encode_bc4(destination, texels.data() + half.channel);
+            }
+        }
+
+        // Squared error of a half block against the texels it encodes
+        auto getHalfError(const HalfBlock& half,
+                          const BlockTexels& texels,
+                          const uint8_t* block) noexcept -> uint32_t
+        {
+            BlockTexels decoded {};
+            uint32_t error = 0;
+
+            if (half.color)
+            {
+                rgbcx::unpack_bc1(block, decoded.data());
+                for (size_t i = 0; i < BLOCK_TEXELS * 4; i++)
+                {
+                    if (i % 4 != 3)
+                    {
+                        int const difference = decoded[i] - texels[i];
+                        error += static_cast<uint32_t>(difference * difference);
+                    }
+                }
+                return error;
+            }
+
+            rgbcx::unpack_bc4(block, decoded.data());
+            for (size_t i = 0; i < BLOCK_TEXELS; i++)
+            {
+                int const difference = decoded[i * 4] - texels[i * 4 + half.channel];
+                error += static_cast<uint32_t>(difference * difference);
+            }
+            return error;
+        }
+
+        /* Replaces a freshly encoded half block with an identical copy of one of the previous ones
+         * in the row, if one decodes closely enough, so that zstd finds the repeat later */
+        void reuseEarlierHalf(const Encoder& encoder,
+                              const HalfBlock& half,
+                              const BlockTexels& texels,
+                              std::span<uint8_t> row,
+                              size_t offset) noexcept
+        {
+            uint8_t* block = row.data() + offset;
+            uint32_t const channels = half.color ? 3 : 1;
+            float const allowed = static_cast<float>(getHalfError(half, texels, block))
+                + encoder.rdoTolerance * static_cast<float>(BLOCK_TEXELS * channels);
+
+            size_t const blockSize = encoder.layout.blockSize;
+            size_t const window = std::min<size_t>(offset / blockSize, encoder.rdoWindow);
+
+            const uint8_t* best = nullptr;
+            float bestError = allowed;
+            for (size_t i = 1; i <= window; i++)
+            {
+                const uint8_t* candidate = block - i * blockSize;
+                if (std::memcmp(candidate, block, HALF_BLOCK_SIZE) == 0)
+                {
+                    return;
+                }
+
+                auto const error = static_cast<float>(getHalfError(half, texels, candidate));
+                if (error <= bestError)
+                {
+                    best = candidate;
+                    bestError = error;
+                }
+            }
+
+            if (best != nullptr)
+            {
+                std::memcpy(block, best, HALF_BLOCK_SIZE);
+            }
+        }
+
+        void encodeRow(const Encoder& encoder,
+                       const uint8_t* slice,
+                       glm::uvec2 extent,
+                       uint32_t blockY,
+                       std::span<uint8_t> row) noexcept
+        {
+            const BlockLayout& layout = encoder.layout;
+            BlockTexels texels {};
+
+            for (uint32_t blockX = 0; blockX * layout.blockSize < row.size(); blockX++)
+            {
+                loadBlock(slice, extent, layout.channels, blockX, blockY, texels);
+
+                size_t const offset = blockX * layout.blockSize;
+                if (layout.halfCount == 0)
+                {
+                    bc7enc_compress_block(row.data() + offset, texels.data(), &encoder.bc7Params);
+                    continue;
+                }
+
+                for (size_t h = 0; h < layout.halfCount; h++)
+                {
+                    size_t const halfOffset = offset + h * HALF_BLOCK_SIZE;
+                    encodeHalf(encoder, layout.halves[h], texels, row.data() + halfOffset);
+
+                    if (encoder.rdoTolerance > 0.F)
+                    {
+                        reuseEarlierHalf(encoder, layout.halves[h], texels, row, halfOffset);
+                    }
+                }
+            }
+        }
+    }  // namespace
+
+    auto isBlockCompressed(Graphics::Format format) noexcept -> bool
+    {
+        return getBlockLayout(format).has_value();
+    }
+
+    auto getBlockSize(Graphics::Format format) noexcept -> size_t
+    {
+        std::optional<BlockLayout> const layout = getBlockLayout(format);
+        debugAssume(layout.has_value(), "Not a BC format");
+        return layout ? layout->blockSize : 0;
+    }
+
+    auto compressTexture(Texture& texture, const BlockCompressionOptions& options) noexcept
+        -> tl::expected<void, Error>
+    {
+        std::optional<Graphics::Format> const format =
+            options.format ? options.format : getDefaultFormat(texture.channels);
+        std::optional<BlockLayout> const layout =
+            format ? getBlockLayout(*format) : std::nullopt;
+
+        if (texture.compressedFormat || texture.bitsPerChannel != 8 || !layout
+            || layout->channels != texture.channels)
+        {
+            return tl::make_unexpected(Errors::FileFormat {});
+        }
+
+        initializeEncoders();
+        Encoder const encoder = makeEncoder(*layout, options);
+
+        struct Slice
+        {
+            const uint8_t* source;
+            glm::uvec2 extent;
+            uint8_t* destination;
+            uint32_t blockRows;
+            size_t rowSize;
+        };
+
+        // Every 2D slice of every mip, laid out one after the other like the source
+        std::vector<Slice> slices;
+        std::vector<Texture::Mip> mips = texture.mips;
+        size_t compressedSize = 0;
+
+        for (Texture::Mip& mip : mips)
+        {
+            size_t const sliceSize = static_cast<size_t>(mip.extent.x) * mip.extent.y
+                * texture.channels;
+            if (sliceSize == 0 || mip.size % sliceSize != 0
+                || mip.offset + mip.size > texture.data.size())
+            {
+                return tl::make_unexpected(Errors::FileFormat {});
+            }
+
+            size_t const blocksX = (mip.extent.x + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+            size_t const blocksY = (mip.extent.y + BLOCK_DIMENSION - 1) / BLOCK_DIMENSION;
+            size_t const rowSize = blocksX * layout->blockSize;
+
+            const auto* source = reinterpret_cast<const uint8_t*>(texture.data.data() + mip.offset);
+            for (size_t s = 0; s < mip.size / sliceSize; s++)
+            {
+                // Destinations are filled in once the output is allocated
+                slices.push_back(Slice {source + s * sliceSize,
+                                        glm::uvec2 {mip.extent},
+                                        nullptr,
+                                        static_cast<uint32_t>(blocksY),
+                                        rowSize});
+            }
+
+            mip.offset = compressedSize;
+            mip.size = (mip.size / sliceSize) * blocksY * rowSize;
+            compressedSize += mip.size;
+        }
+
+        std::vector<std::byte> compressed(compressedSize);
+
+        // One row of blocks per job item; rows are independent, RDO only looks within a row
+        std::vector<std::pair<size_t, uint32_t>> rows;
+        size_t destination = 0;
+        for (Slice& slice : slices)
+        {
+            slice.destination = reinterpret_cast<uint8_t*>(compressed.data() + destination);
+            destination += slice.blockRows * slice.rowSize;
+
+            for (uint32_t y = 0; y < slice.blockRows; y++)
+            {
+                rows.emplace_back(static_cast<size_t>(&slice - slices.data()), y);
+            }
+        }
+
+        JobSystem::getDefault().parallelFor(
+            rows.size(),
+            1,
+            [&](size_t first, size_t last)
+            {
+                for (size_t i = first; i < last; i++)
+                {
+                    auto const [sliceIndex, y] = rows[i];
+                    const Slice& slice = slices[sliceIndex];
+                    encodeRow(encoder,
+                              slice.source,
+                              slice.extent,
+                              y,
+                              {slice.destination + y * slice.rowSize, slice.rowSize});
+                }
+            });
+
+        texture.data = std::move(compressed);
+        texture.mips = std::move(mips);
+        texture.compressedFormat = format;
+
+        return {};
+    }
+}  // namespace exage::Renderer
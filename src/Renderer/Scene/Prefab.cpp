@@ -0,0 +1,26 @@
+#include <optional>
+
+#include "exage/Renderer/Scene/Prefab.h"
+
+#include "exage/Renderer/Scene/BoundingVolumeHierarchy.h"
+
+namespace exage::Renderer
+{
+    auto calculatePrefabBounds(const Prefab& prefab,
+                               std::span<const PrefabOverride> overrides) noexcept -> AABB
+    {
+        std::optional<AABB> bounds;
+
+        forEachPrefabMesh(prefab,
+                          overrides,
+                          glm::mat4 {1.F},
+                          [&](const glm::mat4& matrix, const PrefabMesh& mesh)
+                          {
+                              AABB const nodeBounds = transformAABB(mesh.aabb, matrix);
+                              bounds = bounds ? getUnion(*bounds, nodeBounds) : nodeBounds;
+                          });
+
+        // A placement with every node hidden is an empty box at its origin
+        return bounds.value_or(AABB {});
+    }
+}  // namespace exage::Renderer
@@ -0,0 +1,163 @@
+#include <algorithm>
+
+#include "exage/Renderer/Scene/SpatialIndex.h"
+
+namespace exage::Renderer
+{
+    SpatialIndex::SpatialIndex(Scene& scene, const AssetCache& assetCache) noexcept
+        : _scene(scene)
+        , _assetCache(assetCache)
+        , _transformListener(scene.addTransformListener())
+        , _meshListener(scene.addChangeListener<StaticMeshComponent>())
+        , _prefabListener(scene.addChangeListener<PrefabInstance>())
+        , _transformRemovalListener(scene.addChangeListener<Transform3D>())
+        , _worldRemovalListener(scene.addChangeListener<WorldTransform>())
+    {
+        refreshAll();
+    }
+
+    SpatialIndex::~SpatialIndex()
+    {
+        _scene.removeTransformListener(_transformListener);
+        _scene.removeChangeListener<StaticMeshComponent>(_meshListener);
+        _scene.removeChangeListener<PrefabInstance>(_prefabListener);
+        _scene.removeChangeListener<Transform3D>(_transformRemovalListener);
+        _scene.removeChangeListener<WorldTransform>(_worldRemovalListener);
+    }
+
+    void SpatialIndex::takeChanges() noexcept
+    {
+        auto append = [&](const std::vector<Entity>& entities)
+        { _changes.insert(_changes.end(), entities.begin(), entities.end()); };
+
+        // Any change to the mesh or prefab, whether it was added, replaced or removed
+        _scene.takeChanges<StaticMeshComponent>(_meshListener, _componentChanges);
+        append(_componentChanges.added);
+        append(_componentChanges.updated);
+        append(_componentChanges.removed);
+
+        _scene.takeChanges<PrefabInstance>(_prefabListener, _componentChanges);
+        append(_componentChanges.added);
+        append(_componentChanges.updated);
+        append(_componentChanges.removed);
+
+        // Added or moved transforms come through the transform listener
+        _scene.takeChanges<Transform3D>(_transformRemovalListener, _componentChanges);
+        append(_componentChanges.removed);
+
+        _scene.takeChanges<WorldTransform>(_worldRemovalListener, _componentChanges);
+        append(_componentChanges.removed);
+    }
+
+    void SpatialIndex::update() noexcept
+    {
+        takeChanges();
+        _scene.takeTransformChanges(_transformListener, _transformChanges);
+
+        if (!_transformChanges.all)
+        {
+            for (Entity root : _transformChanges.subtrees)
+            {
+                if (!_scene.isValid(root))
+                {
+                    continue;
+                }
+
+                _traversal.push_back(root);
+                while (!_traversal.empty())
+                {
+                    Entity const entity = _traversal.back();
+                    _traversal.pop_back();
+
+                    _changes.push_back(entity);
+                    _scene.forEachChild(entity,
+                                        [&](Entity child) { _traversal.push_back(child); });
+                }
+            }
+        }
+
+        // Entities whose mesh is still missing are retried, and re-queued by refresh if need be
+        _changes.insert(_changes.end(), _unresolved.begin(), _unresolved.end());
+        _unresolved.clear();
+
+        // Removals only show up here, so they are applied even before a full refresh
+        for (Entity entity : _changes)
+        {
+            refresh(entity);
+        }
+        _changes.clear();
+
+        if (_transformChanges.all)
+        {
+            refreshAll();
+        }
+
+        std::sort(_unresolved.begin(), _unresolved.end());
+        _unresolved.erase(std::unique(_unresolved.begin(), _unresolved.end()), _unresolved.end());
+    }
+
+    void SpatialIndex::refresh(Entity entity) noexcept
+    {
+        const auto& registry = _scene.registry();
+        bool const valid = registry.valid(entity);
+
+        const auto* meshComponent = valid ? registry.try_get<StaticMeshComponent>(entity) : nullptr;
+        const auto* prefabInstance = valid ? registry.try_get<PrefabInstance>(entity) : nullptr;
+
+        std::optional<glm::mat4> world = meshComponent != nullptr || prefabInstance != nullptr
+            ? _scene.getWorldMatrix(entity)
+            : std::nullopt;
+
+        if (!world)
+        {
+            _hierarchy.remove(entity);
+            return;
+        }
+
+        std::optional<AABB> bounds;
+
+        if (meshComponent != nullptr)
+        {
+            const GPUStaticMesh* mesh = _assetCache.getMeshIfExists(meshComponent->mesh);
+            if (mesh == nullptr)
+            {
+                _hierarchy.remove(entity);
+                _unresolved.push_back(entity);
+                return;
+            }
+
+            bounds = mesh->aabb;
+        }
+
+        if (prefabInstance != nullptr)
+        {
+            const Prefab* prefab = _assetCache.getPrefabIfExists(prefabInstance->prefab);
+            if (prefab == nullptr)
+            {
+                _hierarchy.remove(entity);
+                _unresolved.push_back(entity);
+                return;
+            }
+
+            AABB const prefabBounds = prefabInstance->overrides.empty()
+                ? prefab->aabb
+                : calculatePrefabBounds(*prefab, prefabInstance->overrides);
+            bounds = bounds ? getUnion(*bounds, prefabBounds) : prefabBounds;
+        }
+
+        _hierarchy.update(entity, transformAABB(*bounds, *world));
+    }
+
+    void SpatialIndex::refreshAll() noexcept
+    {
+        for (Entity entity : _scene.registry().view<StaticMeshComponent>())
+        {
+            refresh(entity);
+        }
+
+        for (Entity entity : _scene.registry().view<PrefabInstance>())
+        {
+            refresh(entity);
+        }
+    }
+}  // namespace exage::Renderer
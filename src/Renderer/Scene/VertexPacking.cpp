@@ -0,0 +1,295 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <span>
+
+#include "exage/Renderer/Scene/VertexPacking.h"
+
+#include <fp16.h>
+
+#include "exage/Core/Debug.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        using Type = Graphics::VertexAttribute::Type;
+
+        static_assert(sizeof(PackedStaticMeshVertex) == 24, "Packed vertices must stay tight");
+        static_assert(sizeof(QuantizedStaticMeshVertex) == 20, "Packed vertices must stay tight");
+
+        constexpr float SNORM16_MAX = 32767.F;
+        constexpr float UNORM16_MAX = 65535.F;
+
+        auto toSnorm16(float value) noexcept -> int16_t
+        {
+            return static_cast<int16_t>(std::lround(std::clamp(value, -1.F, 1.F) * SNORM16_MAX));
+        }
+
+        auto signNotZero(glm::vec2 value) noexcept -> glm::vec2
+        {
+            return {value.x >= 0.F ? 1.F : -1.F, value.y >= 0.F ? 1.F : -1.F};
+        }
+
+        /* Stores the bitangent's sign in the lowest bit, moving the value by one step toward zero
+         * where needed. That stays clear of -32768, which snorm reads the same as -32767. */
+        auto withSignBit(int16_t value, bool negative) noexcept -> int16_t
+        {
+            if (((value & 1) != 0) == negative)
+            {
+                return value;
+            }
+
+            if (value == 0)
+            {
+                return 1;
+            }
+            return static_cast<int16_t>(value > 0 ? value - 1 : value + 1);
+        }
+
+        auto toHalf(float value) noexcept -> uint16_t
+        {
+            return fp16_ieee_from_fp32_value(value);
+        }
+
+        auto fromHalf(uint16_t value) noexcept -> float
+        {
+            return fp16_ieee_to_fp32_value(value);
+        }
+
+        // Fills in everything but the position, which the two packed formats store differently
+        template<typename Vertex>
+        void packAttributes(const StaticMeshVertex& vertex, Vertex& packed) noexcept
+        {
+            glm::vec3 const normal {vertex.normal};
+            glm::vec3 const tangent {vertex.tangent};
+            glm::vec3 const bitangent {vertex.bitangent};
+
+            packed.normal = encodeOctahedral(normal);
+            packed.tangent = encodeOctahedral(tangent);
+
+            bool const flipped = glm::dot(glm::cross(normal, tangent), bitangent) < 0.F;
+            packed.tangent[1] = withSignBit(packed.tangent[1], flipped);
+
+            packed.uv = {toHalf(vertex.uv.x), toHalf(vertex.uv.y)};
+        }
+
+        template<typename Vertex>
+        void unpackAttributes(const Vertex& packed, StaticMeshVertex& vertex) noexcept
+        {
+            glm::vec3 const normal = decodeOctahedral(packed.normal);
+            glm::vec3 const tangent = decodeOctahedral(packed.tangent);
+            float const sign = (packed.tangent[1] & 1) != 0 ? -1.F : 1.F;
+
+            vertex.normal = glm::vec4(normal, 0.F);
+            vertex.tangent = glm::vec4(tangent, 0.F);
+            vertex.bitangent = glm::vec4(glm::cross(normal, tangent) * sign, 0.F);
+            vertex.uv = glm::vec4(fromHalf(packed.uv[0]), fromHalf(packed.uv[1]), 0.F, 0.F);
+        }
+
+        template<typename Vertex>
+        auto getPacked(StaticMesh& mesh) noexcept -> std::span<Vertex>
+        {
+            debugAssume(mesh.packedVertices.size() % sizeof(Vertex) == 0,
+                        "Packed vertices do not match their format");
+            return {reinterpret_cast<Vertex*>(mesh.packedVertices.data()),
+                    mesh.packedVertices.size() / sizeof(Vertex)};
+        }
+    }  // namespace
+
+    auto getVertexSize(VertexFormat format) noexcept -> size_t
+    {
+        switch (format)
+        {
+            case VertexFormat::eFull:
+                return sizeof(StaticMeshVertex);
+            case VertexFormat::ePacked:
+                return sizeof(PackedStaticMeshVertex);
+            case VertexFormat::eQuantized:
+                return sizeof(QuantizedStaticMeshVertex);
+        }
+        return 0;
+    }
+
+    auto getVertexDescription(VertexFormat format) noexcept -> Graphics::VertexDescription
+    {
+        Graphics::VertexDescription description {};
+        description.stride = static_cast<uint32_t>(getVertexSize(format));
+        description.inputRate = Graphics::VertexDescription::InputRate::eVertex;
+
+        switch (format)
+        {
+            case VertexFormat::eFull:
+                description.attributes = {
+                    {offsetof(StaticMeshVertex, position), 3, Type::eFloat},
+                    {offsetof(StaticMeshVertex, normal), 3, Type::eFloat},
+                    {offsetof(StaticMeshVertex, uv), 2, Type::eFloat},
+                    {offsetof(StaticMeshVertex, tangent), 3, Type::eFloat},
+                    {offsetof(StaticMeshVertex, bitangent), 3, Type::eFloat},
+                };
+                break;
+            case VertexFormat::ePacked:
+                description.attributes = {
+                    {offsetof(PackedStaticMeshVertex, position), 3, Type::eFloat},
+                    {offsetof(PackedStaticMeshVertex, normal), 2, Type::eSnorm16},
+                    {offsetof(PackedStaticMeshVertex, uv), 2, Type::eF16},
+                    {offsetof(PackedStaticMeshVertex, tangent), 2, Type::eSnorm16},
+                };
+                break;
+            case VertexFormat::eQuantized:
+                description.attributes = {
+                    {offsetof(QuantizedStaticMeshVertex, position), 4, Type::eUnorm16},
+                    {offsetof(QuantizedStaticMeshVertex, normal), 2, Type::eSnorm16},
+                    {offsetof(QuantizedStaticMeshVertex, uv), 2, Type::eF16},
+                    {offsetof(QuantizedStaticMeshVertex, tangent), 2, Type::eSnorm16},
+                };
+                break;
+        }
+
+        return description;
+    }
+
+    auto getDequantizationTransform(const AABB& aabb) noexcept -> glm::mat4
+    {
+        glm::vec3 const extent {aabb.max - aabb.min};
+
+        glm::mat4 transform {1.F};
+        transform[0][0] = extent.x;
+        transform[1][1] = extent.y;
+        transform[2][2] = extent.z;
+        transform[3] = glm::vec4(glm::vec3 {aabb.min}, 1.F);
+        return transform;
+    }
+
+    auto encodeOctahedral(glm::vec3 direction) noexcept -> std::array<int16_t, 2>
+    {
+        float const length = std::abs(direction.x) + std::abs(direction.y) + std::abs(direction.z);
+        if (length == 0.F)
+        {
+            return {0, 0};
+        }
+
+        // Onto the octahedron, then the lower half folded over the upper one
+        glm::vec2 encoded = glm::vec2 {direction} / length;
+        if (direction.z < 0.F)
+        {
+            encoded = (1.F - glm::abs(glm::vec2 {encoded.y, encoded.x})) * signNotZero(encoded);
+        }
+
+        return {toSnorm16(encoded.x), toSnorm16(encoded.y)};
+    }
+
+    auto decodeOctahedral(std::array<int16_t, 2> encoded) noexcept -> glm::vec3
+    {
+        // Snorm reads -32768 as -1 too
+        glm::vec2 const value = glm::max(glm::vec2 {encoded[0], encoded[1]} / SNORM16_MAX, -1.F);
+
+        glm::vec3 direction {value, 1.F - std::abs(value.x) - std::abs(value.y)};
+        if (direction.z < 0.F)
+        {
+            glm::vec2 const folded =
+                (1.F - glm::abs(glm::vec2 {direction.y, direction.x})) * signNotZero(value);
+            direction.x = folded.x;
+            direction.y = folded.y;
+        }
+
+        return glm::normalize(direction);
+    }
+
+    void packVertices(StaticMesh& mesh, VertexFormat format) noexcept
+    {
+        if (format == mesh.vertexFormat)
+        {
+            return;
+        }
+
+        unpackVertices(mesh);
+        if (format == VertexFormat::eFull)
+        {
+            return;
+        }
+
+        mesh.packedVertices.resize(mesh.vertices.size() * getVertexSize(format));
+
+        if (format == VertexFormat::ePacked)
+        {
+            std::span<PackedStaticMeshVertex> packed = getPacked<PackedStaticMeshVertex>(mesh);
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                packed[i].position = glm::vec3 {mesh.vertices[i].position};
+                packAttributes(mesh.vertices[i], packed[i]);
+            }
+        }
+        else
+        {
+            glm::vec3 const min {mesh.aabb.min};
+            glm::vec3 const extent = glm::vec3 {mesh.aabb.max} - min;
+            glm::vec3 const scale {
+                extent.x > 0.F ? UNORM16_MAX / extent.x : 0.F,
+                extent.y > 0.F ? UNORM16_MAX / extent.y : 0.F,
+                extent.z > 0.F ? UNORM16_MAX / extent.z : 0.F,
+            };
+
+            std::span<QuantizedStaticMeshVertex> packed =
+                getPacked<QuantizedStaticMeshVertex>(mesh);
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                glm::vec3 const position =
+                    glm::clamp((glm::vec3 {mesh.vertices[i].position} - min) * scale,
+                               0.F,
+                               UNORM16_MAX);
+                // w reads as 1, which the dequantization transform needs for its translation
+                packed[i].position = {static_cast<uint16_t>(std::lround(position.x)),
+                                      static_cast<uint16_t>(std::lround(position.y)),
+                                      static_cast<uint16_t>(std::lround(position.z)),
+                                      std::numeric_limits<uint16_t>::max()};
+                packAttributes(mesh.vertices[i], packed[i]);
+            }
+        }
+
+        mesh.vertexFormat = format;
+        mesh.vertices.clear();
+        mesh.vertices.shrink_to_fit();
+    }
+
+    void unpackVertices(StaticMesh& mesh) noexcept
+    {
+        if (mesh.vertexFormat == VertexFormat::eFull)
+        {
+            return;
+        }
+
+        if (mesh.vertexFormat == VertexFormat::ePacked)
+        {
+            std::span<PackedStaticMeshVertex> packed = getPacked<PackedStaticMeshVertex>(mesh);
+            mesh.vertices.resize(packed.size());
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                mesh.vertices[i].position = glm::vec4(packed[i].position, 1.F);
+                unpackAttributes(packed[i], mesh.vertices[i]);
+            }
+        }
+        else
+        {
+            glm::mat4 const dequantize = getDequantizationTransform(mesh.aabb);
+
+            std::span<QuantizedStaticMeshVertex> packed =
+                getPacked<QuantizedStaticMeshVertex>(mesh);
+            mesh.vertices.resize(packed.size());
+            for (size_t i = 0; i < packed.size(); i++)
+            {
+                glm::vec3 const position {packed[i].position[0],
+                                          packed[i].position[1],
+                                          packed[i].position[2]};
+                mesh.vertices[i].position = dequantize * glm::vec4(position / UNORM16_MAX, 1.F);
+                unpackAttributes(packed[i], mesh.vertices[i]);
+            }
+        }
+
+        mesh.vertexFormat = VertexFormat::eFull;
+        mesh.packedVertices.clear();
+        mesh.packedVertices.shrink_to_fit();
+    }
+}  // namespace exage::Renderer
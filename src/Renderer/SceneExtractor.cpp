@@ -0,0 +1,351 @@
+#include <algorithm>
+
+#include "exage/Renderer/SceneExtractor.h"
+
+#include "exage/Core/Debug.h"
+#include "exage/utils/math.h"
+
+namespace exage::Renderer
+{
+    namespace
+    {
+        // A slot that falls this far behind is cheaper to rebuild than to patch entity by entity
+        constexpr size_t MIN_PENDING_BEFORE_REBUILD = 1024;
+
+        auto getDirection(const glm::mat4& world) noexcept -> glm::vec3
+        {
+            return glm::normalize(glm::mat3 {world} * Z_AXIS);
+        }
+
+        auto makeInstance(const StaticMeshComponent& mesh, const glm::mat4& world) noexcept
+            -> MeshInstance
+        {
+            return {world, world, mesh.mesh};
+        }
+
+        auto makeInstance(const PrefabInstance& prefab, const glm::mat4& world) noexcept
+            -> PrefabPlacement
+        {
+            return {world, world, prefab.prefab, prefab.overrides};
+        }
+
+        auto makeInstance(const Camera& camera, const glm::mat4& world) noexcept -> CameraInstance
+        {
+            return {world, world, camera};
+        }
+
+        auto makeInstance(const PointLight& light, const glm::mat4& world) noexcept
+            -> PointLightInstance
+        {
+            return {glm::vec3 {world[3]}, light};
+        }
+
+        auto makeInstance(const SpotLight& light, const glm::mat4& world) noexcept
+            -> SpotLightInstance
+        {
+            return {glm::vec3 {world[3]}, getDirection(world), light};
+        }
+
+        auto makeInstance(const DirectionalLight& light, const glm::mat4& world) noexcept
+            -> DirectionalLightInstance
+        {
+            return {getDirection(world), light};
+        }
+
+        // Takes the model from the latest snapshot, or keeps the current one for new instances
+        template<typename Instance>
+        void setPreviousModel(Instance& instance,
+                              const PackedInstances<Instance>* previous,
+                              Entity entity) noexcept
+        {
+            if constexpr (requires { instance.previousModel; })
+            {
+                const Instance* last = previous != nullptr ? previous->find(entity) : nullptr;
+                if (last != nullptr)
+                {
+                    instance.previousModel = last->model;
+                }
+            }
+        }
+
+        // An entity without a world transform is not rendered at all
+        template<typename Component, typename Instance>
+        void refreshInstance(const Scene::Registry& registry,
+                             PackedInstances<Instance>& packed,
+                             const PackedInstances<Instance>* previous,
+                             Entity entity,
+                             const std::optional<glm::mat4>& world) noexcept
+        {
+            const auto* component = world ? registry.try_get<Component>(entity) : nullptr;
+            if (component != nullptr)
+            {
+                Instance instance = makeInstance(*component, *world);
+                setPreviousModel(instance, previous, entity);
+                packed.set(entity, instance);
+            }
+            else
+            {
+                packed.erase(entity);
+            }
+        }
+
+        template<typename Component, typename Instance>
+        void rebuildInstances(const Scene& scene,
+                              PackedInstances<Instance>& packed,
+                              const PackedInstances<Instance>* previous) noexcept
+        {
+            packed.clear();
+
+            auto view = scene.registry().view<Component>();
+            for (Entity entity : view)
+            {
+                if (std::optional<glm::mat4> world = scene.getWorldMatrix(entity))
+                {
+                    Instance instance = makeInstance(view.template get<Component>(entity), *world);
+                    setPreviousModel(instance, previous, entity);
+                    packed.set(entity, instance);
+                }
+            }
+        }
+
+        auto instanceCount(const RenderSnapshot& snapshot) noexcept -> size_t
+        {
+            return snapshot.meshes.size() + snapshot.prefabs.size() + snapshot.cameras.size()
+                + snapshot.pointLights.size() + snapshot.spotLights.size()
+                + snapshot.directionalLights.size();
+        }
+    }  // namespace
+
+    SceneExtractor::SceneExtractor(Scene& scene) noexcept
+        : _scene(scene)
+        , _transformListener(scene.addTransformListener())
+    {
+        connectSignals<Transform3D,
+                       CompactTransform,
+                       StaticMeshComponent,
+                       PrefabInstance,
+                       Camera,
+                       PointLight,
+                       SpotLight,
+                       DirectionalLight>();
+    }
+
+    SceneExtractor::~SceneExtractor()
+    {
+        _scene.removeTransformListener(_transformListener);
+        disconnectSignals<Transform3D,
+                          CompactTransform,
+                          StaticMeshComponent,
+                          PrefabInstance,
+                          Camera,
+                          PointLight,
+                          SpotLight,
+                          DirectionalLight>();
+
+#if EXAGE_USE_ASSERTS
+        for (const Slot& slot : _slots)
+        {
+            debugAssert(slot.state.load() == 0, "Render snapshot still acquired");
+        }
+#endif
+    }
+
+    template<typename... Components>
+    void SceneExtractor::connectSignals() noexcept
+    {
+        auto& registry = _scene.registry();
+        (registry.on_construct<Components>().template connect<&SceneExtractor::recordChange>(*this),
+         ...);
+        (registry.on_update<Components>().template connect<&SceneExtractor::recordChange>(*this),
+         ...);
+        (registry.on_destroy<Components>().template connect<&SceneExtractor::recordChange>(*this),
+         ...);
+    }
+
+    template<typename... Components>
+    void SceneExtractor::disconnectSignals() noexcept
+    {
+        auto& registry = _scene.registry();
+        (registry.on_construct<Components>().disconnect(*this), ...);
+        (registry.on_update<Components>().disconnect(*this), ...);
+        (registry.on_destroy<Components>().disconnect(*this), ...);
+    }
+
+    void SceneExtractor::recordChange(Scene::Registry& /*registry*/, Entity entity) noexcept
+    {
+        // Destroy signals fire before the component is gone, so it is only looked at on extract
+        _changes.push_back(entity);
+    }
+
+    void SceneExtractor::collectTransformChanges() noexcept
+    {
+        _scene.takeTransformChanges(_transformListener, _transformChanges);
+
+        if (_transformChanges.all)
+        {
+            for (Slot& slot : _slots)
+            {
+                slot.stale = true;
+                slot.pending.clear();
+            }
+            return;
+        }
+
+        for (Entity root : _transformChanges.subtrees)
+        {
+            if (!_scene.isValid(root))
+            {
+                continue;
+            }
+
+            _traversal.push_back(root);
+            while (!_traversal.empty())
+            {
+                Entity const entity = _traversal.back();
+                _traversal.pop_back();
+
+                _changes.push_back(entity);
+                _scene.forEachChild(entity, [&](Entity child) { _traversal.push_back(child); });
+            }
+        }
+    }
+
+    void SceneExtractor::extract() noexcept
+    {
+        collectTransformChanges();
+
+        // Every slot has to see this frame's changes before it is handed out again, and the
+        // previous frame's ones too, whose previous model now matches their model
+        for (Slot& slot : _slots)
+        {
+            if (slot.stale)
+            {
+                continue;
+            }
+
+            slot.pending.insert(slot.pending.end(), _changes.begin(), _changes.end());
+            slot.pending.insert(
+                slot.pending.end(), _previousChanges.begin(), _previousChanges.end());
+
+            if (slot.pending.size()
+                > std::max(instanceCount(slot.snapshot), MIN_PENDING_BEFORE_REBUILD))
+            {
+                slot.stale = true;
+                slot.pending.clear();
+            }
+        }
+        std::swap(_changes, _previousChanges);
+        _changes.clear();
+
+        size_t const latest = _latest.load(std::memory_order_relaxed);
+        size_t const next = latest == SNAPSHOT_COUNT ? 0 : (latest + 1) % SNAPSHOT_COUNT;
+        Slot& slot = _slots[next];
+
+        // Wait for the renderer to let go of it, if it still holds it
+        int32_t readers = 0;
+        while (!slot.state.compare_exchange_weak(
+            readers, WRITING, std::memory_order_acquire, std::memory_order_relaxed))
+        {
+            if (readers != 0)
+            {
+                slot.state.wait(readers, std::memory_order_relaxed);
+                readers = 0;
+            }
+        }
+
+        // Only read, so the renderer may hold it meanwhile
+        const RenderSnapshot* previous =
+            latest == SNAPSHOT_COUNT ? nullptr : &_slots[latest].snapshot;
+
+        if (slot.stale)
+        {
+            refreshAll(slot.snapshot, previous);
+        }
+        else
+        {
+            for (Entity entity : slot.pending)
+            {
+                refresh(slot.snapshot, previous, entity);
+            }
+        }
+
+        slot.stale = false;
+        slot.pending.clear();
+        slot.snapshot.frame = ++_frame;
+
+        slot.state.store(0, std::memory_order_release);
+        _latest.store(next, std::memory_order_release);
+    }
+
+    auto SceneExtractor::acquire() noexcept -> const RenderSnapshot*
+    {
+        while (true)
+        {
+            size_t const latest = _latest.load(std::memory_order_acquire);
+            if (latest == SNAPSHOT_COUNT)
+            {
+                return nullptr;
+            }
+
+            Slot& slot = _slots[latest];
+            int32_t readers = slot.state.load(std::memory_order_relaxed);
+            while (readers != WRITING)
+            {
+                if (slot.state.compare_exchange_weak(
+                        readers, readers + 1, std::memory_order_acquire, std::memory_order_relaxed))
+                {
+                    return &slot.snapshot;
+                }
+            }
+
+            // Only slots other than the latest are written, so a newer one has been published
+        }
+    }
+
+    void SceneExtractor::release(const RenderSnapshot& snapshot) noexcept
+    {
+        auto slot = std::find_if(_slots.begin(),
+                                 _slots.end(),
+                                 [&](const Slot& candidate)
+                                 { return &candidate.snapshot == &snapshot; });
+        debugAssume(slot != _slots.end(), "Snapshot does not belong to this extractor");
+
+        if (slot->state.fetch_sub(1, std::memory_order_release) == 1)
+        {
+            slot->state.notify_all();
+        }
+    }
+
+    void SceneExtractor::refresh(RenderSnapshot& snapshot,
+                                 const RenderSnapshot* previous,
+                                 Entity entity) noexcept
+    {
+        const auto& registry = _scene.registry();
+        std::optional<glm::mat4> world =
+            registry.valid(entity) ? _scene.getWorldMatrix(entity) : std::nullopt;
+
+        refreshInstance<StaticMeshComponent>(
+            registry, snapshot.meshes, previous ? &previous->meshes : nullptr, entity, world);
+        refreshInstance<PrefabInstance>(
+            registry, snapshot.prefabs, previous ? &previous->prefabs : nullptr, entity, world);
+        refreshInstance<Camera>(
+            registry, snapshot.cameras, previous ? &previous->cameras : nullptr, entity, world);
+        refreshInstance<PointLight>(registry, snapshot.pointLights, nullptr, entity, world);
+        refreshInstance<SpotLight>(registry, snapshot.spotLights, nullptr, entity, world);
+        refreshInstance<DirectionalLight>(
+            registry, snapshot.directionalLights, nullptr, entity, world);
+    }
+
+    void SceneExtractor::refreshAll(RenderSnapshot& snapshot,
+                                    const RenderSnapshot* previous) noexcept
+    {
+        rebuildInstances<StaticMeshComponent>(
+            _scene, snapshot.meshes, previous ? &previous->meshes : nullptr);
+        rebuildInstances<PrefabInstance>(
+            _scene, snapshot.prefabs, previous ? &previous->prefabs : nullptr);
+        rebuildInstances<Camera>(_scene, snapshot.cameras, previous ? &previous->cameras : nullptr);
+        rebuildInstances<PointLight>(_scene, snapshot.pointLights, nullptr);
+        rebuildInstances<SpotLight>(_scene, snapshot.spotLights, nullptr);
+        rebuildInstances<DirectionalLight>(_scene, snapshot.directionalLights, nullptr);
+    }
+}  // namespace exage::Renderer
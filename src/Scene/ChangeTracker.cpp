@@ -0,0 +1,100 @@
+#include <algorithm>
+
+#include "exage/Scene/ChangeTracker.h"
+
+#include "exage/Core/Debug.h"
+
+namespace exage
+{
+    auto ChangeTracker::addListener() noexcept -> Listener
+    {
+        auto free = std::find(_listeners.begin(), _listeners.end(), std::nullopt);
+        if (free == _listeners.end())
+        {
+            free = _listeners.emplace(_listeners.end());
+        }
+
+        free->emplace();
+        _listenerCount++;
+        return static_cast<Listener>(free - _listeners.begin());
+    }
+
+    void ChangeTracker::removeListener(Listener listener) noexcept
+    {
+        debugAssume(listener < _listeners.size() && _listeners[listener],
+                    "Invalid change listener");
+
+        _listeners[listener].reset();
+        _listenerCount--;
+    }
+
+    void ChangeTracker::take(Listener listener, ComponentChanges& changes) noexcept
+    {
+        debugAssume(listener < _listeners.size() && _listeners[listener],
+                    "Invalid change listener");
+
+        changes.clear();
+
+        auto& recorded = *_listeners[listener];
+        for (auto [entity, change] : recorded)
+        {
+            switch (change)
+            {
+                case Change::eAdded:
+                    changes.added.push_back(entity);
+                    break;
+                case Change::eUpdated:
+                    changes.updated.push_back(entity);
+                    break;
+                case Change::eRemoved:
+                    changes.removed.push_back(entity);
+                    break;
+            }
+        }
+
+        recorded.clear();
+    }
+
+    void ChangeTracker::record(Entity entity, Change change) noexcept
+    {
+        if (_listenerCount == 0)
+        {
+            return;
+        }
+
+        for (auto& recorded : _listeners)
+        {
+            if (!recorded)
+            {
+                continue;
+            }
+
+            auto [it, inserted] = recorded->try_emplace(entity, change);
+            if (inserted)
+            {
+                continue;
+            }
+
+            // Combined with what the listener has not taken yet
+            Change& previous = it->second;
+            switch (change)
+            {
+                case Change::eAdded:
+                    previous = Change::eUpdated;  // Only a removal can precede an addition
+                    break;
+                case Change::eUpdated:
+                    break;  // Still added, or still updated
+                case Change::eRemoved:
+                    if (previous == Change::eAdded)
+                    {
+                        recorded->erase(it);
+                    }
+                    else
+                    {
+                        previous = Change::eRemoved;
+                    }
+                    break;
+            }
+        }
+    }
+}  // namespace exage
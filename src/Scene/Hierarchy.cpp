@@ -1 +1,34 @@
-﻿
\ No newline at end of file
+﻿#include "exage/Scene/Hierarchy.h"
+
+namespace exage
+{
+    void propagateRootTransform(Transform3D& transform) noexcept
+    {
+        transform.globalRotation = transform.rotation;
+        transform.globalPosition = transform.position;
+        transform.globalScale = transform.scale;
+        transform.matrix = calculateTransformMatrix(transform);
+        transform.globalMatrix = transform.matrix;
+    }
+
+    void propagateChildTransform(const Transform3D& parent, Transform3D& child) noexcept
+    {
+        propagateChildTransform(parent, parent.globalRotation.getRotationMatrix3(), child);
+    }
+
+    void propagateChildTransform(const Transform3D& parent,
+                                 const glm::mat3& parentRotation,
+                                 Transform3D& child) noexcept
+    {
+        glm::quat childRotation = child.rotation.getQuaternion();
+
+        child.globalRotation = parent.globalRotation * childRotation;
+        child.globalScale = parent.globalScale * child.scale;
+
+        child.matrix = calculateTransformMatrix(child);
+        child.globalMatrix = parent.globalMatrix * child.matrix;
+
+        child.globalPosition =
+            parent.globalPosition + parentRotation * (parent.globalScale * child.position);
+    }
+}  // namespace exage
@@ -1 +1,200 @@
+#include <array>
+#include <cstddef>
+
 #include "exage/Scene/Rotation3D.h"
+
+#include "Core/SimdLanes.h"
+#include "exage/Core/Debug.h"
+
+namespace exage
+{
+    namespace
+    {
+#if EXAGE_SIMD
+        using namespace detail;
+
+        static_assert(sizeof(glm::quat) == 4 * sizeof(float) && offsetof(glm::quat, x) == 0,
+                      "The batched conversions expect quaternions stored as x, y, z, w");
+        static_assert(sizeof(glm::mat3) == 9 * sizeof(float), "mat3 is expected to be packed");
+
+        /* Same operations in the same order as glm::mat3_cast, for four quaternions given as
+         * lanes of x, y, z and w. This stays four wide even with AVX: moving data between the
+         * halves of eight-wide registers costs more than the few multiplications it would save. */
+        void quaternionQuadToMatrix(__m128 x,
+                                    __m128 y,
+                                    __m128 z,
+                                    __m128 w,
+                                    __m128 (&out)[9]) noexcept  // NOLINT(*-avoid-c-arrays)
+        {
+            __m128 const qxx = _mm_mul_ps(x, x);
+            __m128 const qyy = _mm_mul_ps(y, y);
+            __m128 const qzz = _mm_mul_ps(z, z);
+            __m128 const qxz = _mm_mul_ps(x, z);
+            __m128 const qxy = _mm_mul_ps(x, y);
+            __m128 const qyz = _mm_mul_ps(y, z);
+            __m128 const qwx = _mm_mul_ps(w, x);
+            __m128 const qwy = _mm_mul_ps(w, y);
+            __m128 const qwz = _mm_mul_ps(w, z);
+
+            __m128 const one = _mm_set1_ps(1.F);
+            __m128 const two = _mm_set1_ps(2.F);
+
+            out[0] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qyy, qzz)));
+            out[1] = _mm_mul_ps(two, _mm_add_ps(qxy, qwz));
+            out[2] = _mm_mul_ps(two, _mm_sub_ps(qxz, qwy));
+            out[3] = _mm_mul_ps(two, _mm_sub_ps(qxy, qwz));
+            out[4] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qzz)));
+            out[5] = _mm_mul_ps(two, _mm_add_ps(qyz, qwx));
+            out[6] = _mm_mul_ps(two, _mm_add_ps(qxz, qwy));
+            out[7] = _mm_mul_ps(two, _mm_sub_ps(qyz, qwx));
+            out[8] = _mm_sub_ps(one, _mm_mul_ps(two, _mm_add_ps(qxx, qyy)));
+        }
+
+        // Lanes that are all ones where the (integral) value is odd
+        inline auto oddMask(Lanes value) noexcept -> Lanes
+        {
+            return notEqual(value, mul(splat(2.F), roundLanes(mul(value, splat(0.5F)))));
+        }
+
+        /* Cephes-style sine and cosine: the angle is reduced by the nearest multiple of pi/2 in
+         * three steps, then both minimax polynomials are evaluated and swapped and negated by
+         * quadrant. Only float operations are used, so plain AVX is enough. */
+        void sinCos(Lanes angle, Lanes& sine, Lanes& cosine) noexcept
+        {
+            Lanes const quadrant = roundLanes(mul(angle, splat(0.636619772367581343F)));
+
+            Lanes r = sub(angle, mul(quadrant, splat(1.5703125F)));
+            r = sub(r, mul(quadrant, splat(4.837512969970703125e-4F)));
+            r = sub(r, mul(quadrant, splat(7.54978995489188216e-8F)));
+
+            Lanes const r2 = mul(r, r);
+
+            Lanes s = add(mul(splat(-1.9515295891e-4F), r2), splat(8.3321608736e-3F));
+            s = add(mul(s, r2), splat(-1.6666654611e-1F));
+            s = add(mul(mul(s, r2), r), r);
+
+            Lanes c = add(mul(splat(2.443315711809948e-5F), r2), splat(-1.388731625493765e-3F));
+            c = add(mul(c, r2), splat(4.166664568298827e-2F));
+            c = add(mul(mul(c, r2), r2), sub(splat(1.F), mul(splat(0.5F), r2)));
+
+            // With k = quadrant mod 4: k is odd swaps sine and cosine, k in {2, 3} negates the
+            // sine and k in {1, 2} negates the cosine
+            Lanes const swap = oddMask(quadrant);
+            Lanes const odd = bitAnd(swap, splat(1.F));
+            Lanes const half = splat(0.5F);
+            Lanes const negateSine = oddMask(mul(sub(quadrant, odd), half));
+            Lanes const negateCosine = oddMask(mul(add(quadrant, odd), half));
+
+            Lanes const signBit = splat(-0.F);
+            sine = bitXor(select(swap, c, s), bitAnd(negateSine, signBit));
+            cosine = bitXor(select(swap, s, c), bitAnd(negateCosine, signBit));
+        }
+#endif
+
+        auto eulerToQuaternion(glm::vec3 euler, RotationType type) noexcept -> glm::quat
+        {
+            return Rotation3D {euler, type}.getQuaternion();
+        }
+    }  // namespace
+
+    void quaternionsToMatrices(std::span<const glm::quat> quaternions,
+                               std::span<glm::mat3> matrices) noexcept
+    {
+        debugAssume(quaternions.size() == matrices.size(), "Rotation spans differ in size");
+
+        size_t i = 0;
+
+#if EXAGE_SIMD
+        for (; i + 4 <= quaternions.size(); i += 4)
+        {
+            // Transposed into lanes of x, y, z and w
+            const float* source = &quaternions[i].x;
+            __m128 x = _mm_loadu_ps(source);
+            __m128 y = _mm_loadu_ps(source + 4);
+            __m128 z = _mm_loadu_ps(source + 8);
+            __m128 w = _mm_loadu_ps(source + 12);
+            _MM_TRANSPOSE4_PS(x, y, z, w);
+
+            __m128 out[9];  // NOLINT(*-avoid-c-arrays)
+            quaternionQuadToMatrix(x, y, z, w, out);
+
+            // And back; the matrices are contiguous, nine floats each
+            _MM_TRANSPOSE4_PS(out[0], out[1], out[2], out[3]);
+            _MM_TRANSPOSE4_PS(out[4], out[5], out[6], out[7]);
+
+            alignas(16) std::array<float, 4> last {};
+            _mm_store_ps(last.data(), out[8]);
+
+            for (size_t lane = 0; lane < 4; lane++)
+            {
+                float* destination = &matrices[i + lane][0][0];
+                _mm_storeu_ps(destination, out[lane]);
+                _mm_storeu_ps(destination + 4, out[4 + lane]);
+                destination[8] = last[lane];
+            }
+        }
+#endif
+
+        for (; i < quaternions.size(); i++)
+        {
+            matrices[i] = glm::toMat3(quaternions[i]);
+        }
+    }
+
+    void eulerToQuaternions(std::span<const glm::vec3> eulers,
+                            std::span<glm::quat> quaternions,
+                            RotationType type) noexcept
+    {
+        debugAssume(eulers.size() == quaternions.size(), "Rotation spans differ in size");
+
+        size_t i = 0;
+
+#if EXAGE_SIMD
+        if (type != RotationType::eQuaternion)
+        {
+            // Yaw-pitch-roll angles are stored with pitch and yaw swapped
+            bool const swapped = type == RotationType::eYawPitchRoll;
+
+            alignas(32) std::array<std::array<float, LANE_COUNT>, 3> in {};
+            alignas(32) std::array<std::array<float, LANE_COUNT>, 4> out {};
+
+            for (; i + LANE_COUNT <= eulers.size(); i += LANE_COUNT)
+            {
+                for (size_t lane = 0; lane < LANE_COUNT; lane++)
+                {
+                    const glm::vec3& euler = eulers[i + lane];
+                    in[0][lane] = swapped ? euler.y : euler.x;
+                    in[1][lane] = swapped ? euler.x : euler.y;
+                    in[2][lane] = euler.z;
+                }
+
+                // Same products in the same order as glm's Euler angle constructor
+                Lanes const half = splat(0.5F);
+                Lanes sx, cx, sy, cy, sz, cz;  // NOLINT(*-isolate-declaration)
+                sinCos(mul(loadLanes(in[0].data()), half), sx, cx);
+                sinCos(mul(loadLanes(in[1].data()), half), sy, cy);
+                sinCos(mul(loadLanes(in[2].data()), half), sz, cz);
+
+                storeLanes(out[0].data(), sub(mul(mul(sx, cy), cz), mul(mul(cx, sy), sz)));
+                storeLanes(out[1].data(), add(mul(mul(cx, sy), cz), mul(mul(sx, cy), sz)));
+                storeLanes(out[2].data(), sub(mul(mul(cx, cy), sz), mul(mul(sx, sy), cz)));
+                storeLanes(out[3].data(), add(mul(mul(cx, cy), cz), mul(mul(sx, sy), sz)));
+
+                for (size_t lane = 0; lane < LANE_COUNT; lane++)
+                {
+                    glm::quat& quaternion = quaternions[i + lane];
+                    quaternion.x = out[0][lane];
+                    quaternion.y = out[1][lane];
+                    quaternion.z = out[2][lane];
+                    quaternion.w = out[3][lane];
+                }
+            }
+        }
+#endif
+
+        for (; i < eulers.size(); i++)
+        {
+            quaternions[i] = eulerToQuaternion(eulers[i], type);
+        }
+    }
+}  // namespace exage
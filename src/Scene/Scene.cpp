@@ -1,11 +1,57 @@
-﻿#include "exage/Scene/Scene.h"
+﻿#include <algorithm>
+#include <unordered_map>
+#include <utility>
 
+#include "exage/Scene/Scene.h"
+
+#include "exage/Core/Debug.h"
+#include "exage/Core/JobSystem.h"
 #include "exage/Scene/Entity.h"
 #include "exage/Scene/Hierarchy.h"
 #include "exage/utils/math.h"
 
 namespace exage
 {
+    namespace
+    {
+        // Below this many transforms per job, scheduling costs more than it saves
+        constexpr size_t MIN_FLAT_TRANSFORMS_PER_JOB = 4096;
+
+        // Past this share of dirty transforms, a full pass is cheaper than walking up from each
+        constexpr size_t FULL_UPDATE_DIRTY_DIVISOR = 16;
+
+        // Subtrees gathered per job when destroying; below this, gathering stays on this thread
+        constexpr size_t MIN_DESTROYED_SUBTREES_PER_JOB = 256;
+
+        void recordRemovedTransform(std::vector<Entity>& removed,
+                                    Scene::Registry& /*registry*/,
+                                    Entity entity) noexcept
+        {
+            removed.push_back(entity);
+        }
+    }  // namespace
+
+    Scene::Scene(std::pmr::memory_resource* resource) noexcept
+        : _registry(Allocator {resource})
+    {
+        _registry.on_construct<Transform3D>()
+            .connect<&Registry::emplace_or_replace<TransformDirty>>();
+        _registry.on_update<Transform3D>().connect<&Registry::emplace_or_replace<TransformDirty>>();
+
+        _registry.on_construct<CompactTransform>()
+            .connect<&Registry::emplace_or_replace<WorldTransform>>();
+        _registry.on_construct<CompactTransform>()
+            .connect<&Registry::emplace_or_replace<TransformDirty>>();
+        _registry.on_update<CompactTransform>()
+            .connect<&Registry::emplace_or_replace<TransformDirty>>();
+
+        // Only recorded here: on_destroy also fires while whole subtrees are being destroyed, when
+        // neither the entity nor its children may take on components anymore
+        _registry.on_destroy<Transform3D>().connect<&recordRemovedTransform>(*_removedTransforms);
+        _registry.on_destroy<CompactTransform>().connect<&recordRemovedTransform>(
+            *_removedTransforms);
+    }
+
     auto Scene::createEntity(Entity parent) noexcept -> Entity
     {
         Entity entity = _registry.create();
@@ -29,14 +75,249 @@ namespace exage
             parentRelationship.firstChild = entity;
             parentRelationship.childCount++;
         }
+        else
+        {
+            _registry.emplace<RootEntity>(entity);
+        }
 
+        _depthFirstDirty = true;
         return entity;
     }
 
     void Scene::destroyEntity(Entity entity) noexcept
     {
-        auto& relationship = getComponent<EntityRelationship>(entity);
+        destroySubtrees(std::span {&entity, 1});
+    }
+
+    auto Scene::createEntities(size_t count, Entity parent) noexcept -> std::vector<Entity>
+    {
+        return createLinked(count, {}, parent);
+    }
+
+    auto Scene::instantiate(const ScenePrefab& prefab, Entity parent) noexcept
+        -> std::vector<Entity>
+    {
+        debugAssume(prefab.transforms.empty() || prefab.parents.size() == prefab.transforms.size(),
+                    "Prefab parents and transforms differ in size");
+        debugAssume(
+            prefab.externalParents.empty()
+                || prefab.parents.size() == prefab.externalParents.size(),
+            "Prefab parents and external parents differ in size");
+
+        std::vector<Entity> entities =
+            createLinked(prefab.parents.size(), prefab.parents, parent, prefab.externalParents);
+        if (!prefab.transforms.empty())
+        {
+            addComponents<Transform3D>(entities, prefab.transforms.begin());
+        }
+        return entities;
+    }
+
+    auto Scene::createLinked(size_t count,
+                             std::span<const size_t> parents,
+                             Entity parent,
+                             std::span<const Entity> externalParents) noexcept
+        -> std::vector<Entity>
+    {
+        std::vector<Entity> entities(count);
+        _registry.create(entities.begin(), entities.end());
+
+        // Link everything locally first, prepending like createEntity does, so the registry only
+        // sees one insert per component type. Slot `count` collects the top-level nodes.
+        std::vector<EntityRelationship> relationships(count);
+        std::vector<size_t> firstChild(count + 1, ScenePrefab::NO_PARENT);
+        std::vector<Entity> roots;
+        std::vector<size_t> attached;  // Top-level nodes with an external parent of their own
+
+        size_t lastTopLevel = ScenePrefab::NO_PARENT;
+        uint32_t topLevelCount = 0;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            size_t const parentIndex = parents.empty() ? ScenePrefab::NO_PARENT : parents[i];
+            auto& relationship = relationships[i];
+
+            if (parentIndex == ScenePrefab::NO_PARENT)
+            {
+                relationship.parent = externalParents.empty() ? parent : externalParents[i];
+
+                if (relationship.parent == entt::null)
+                {
+                    roots.push_back(entities[i]);
+                    continue;
+                }
+
+                if (!externalParents.empty())
+                {
+                    attached.push_back(i);
+                    continue;
+                }
+
+                if (lastTopLevel == ScenePrefab::NO_PARENT)
+                {
+                    lastTopLevel = i;
+                }
+                topLevelCount++;
+            }
+            else
+            {
+                debugAssume(parentIndex < i, "Prefab parents must come before their children");
+
+                relationship.parent = entities[parentIndex];
+                relationships[parentIndex].firstChild = entities[i];
+                relationships[parentIndex].childCount++;
+            }
+
+            size_t& slot = firstChild[parentIndex == ScenePrefab::NO_PARENT ? count : parentIndex];
+            if (slot != ScenePrefab::NO_PARENT)
+            {
+                relationship.nextSibling = entities[slot];
+                relationships[slot].previousSibling = entities[i];
+            }
+            slot = i;
+        }
+
+        if (topLevelCount > 0)
+        {
+            auto& parentRelationship = getComponent<EntityRelationship>(parent);
+
+            if (parentRelationship.firstChild != entt::null)
+            {
+                auto& firstChildRelationship =
+                    getComponent<EntityRelationship>(parentRelationship.firstChild);
+
+                firstChildRelationship.previousSibling = entities[lastTopLevel];
+                relationships[lastTopLevel].nextSibling = parentRelationship.firstChild;
+            }
+
+            parentRelationship.firstChild = entities[firstChild[count]];
+            parentRelationship.childCount += topLevelCount;
+        }
+
+        // Prepended one at a time, as createEntity would. A previous first child from this call
+        // is not in the registry yet, so the last node attached to each parent is remembered.
+        std::unordered_map<Entity, size_t> lastAttached;
+        for (size_t i : attached)
+        {
+            auto& relationship = relationships[i];
+            auto& parentRelationship = getComponent<EntityRelationship>(relationship.parent);
+
+            if (parentRelationship.firstChild != entt::null)
+            {
+                auto const previous = lastAttached.find(relationship.parent);
+                auto& firstChildRelationship = previous != lastAttached.end()
+                    ? relationships[previous->second]
+                    : getComponent<EntityRelationship>(parentRelationship.firstChild);
+
+                firstChildRelationship.previousSibling = entities[i];
+                relationship.nextSibling = parentRelationship.firstChild;
+            }
+
+            parentRelationship.firstChild = entities[i];
+            parentRelationship.childCount++;
+            lastAttached[relationship.parent] = i;
+        }
+
+        _registry.insert<EntityRelationship>(
+            entities.begin(), entities.end(), relationships.begin());
+        _registry.insert<RootEntity>(roots.begin(), roots.end());
+
+        _depthFirstDirty = true;
+        return entities;
+    }
+
+    void Scene::destroySubtrees(std::span<const Entity> entities) noexcept
+    {
+        std::vector<Entity> subtreeRoots {entities.begin(), entities.end()};
+        std::sort(subtreeRoots.begin(), subtreeRoots.end());
+        subtreeRoots.erase(std::unique(subtreeRoots.begin(), subtreeRoots.end()),
+                           subtreeRoots.end());
+
+        // Unlink every root before gathering, so a root nested in another one is only visited once
+        for (Entity entity : subtreeRoots)
+        {
+            detach(entity, getComponent<EntityRelationship>(entity));
+        }
+
+        destroyDetached(subtreeRoots);
+    }
+
+    auto Scene::destroyPending() noexcept -> size_t
+    {
+        auto view = _registry.view<PendingDestroy>();
+        if (view.empty())
+        {
+            return 0;
+        }
+
+        std::vector<Entity> subtreeRoots {view.begin(), view.end()};
+        for (Entity entity : subtreeRoots)
+        {
+            detach(entity, getComponent<EntityRelationship>(entity));
+        }
+
+        return destroyDetached(subtreeRoots);
+    }
 
+    auto Scene::destroyDetached(std::span<const Entity> subtreeRoots) noexcept -> size_t
+    {
+        // The links are only read from here on, so independent subtrees are gathered in parallel,
+        // each chunk of roots into a list of its own
+        const auto& relationships = _registry.storage<EntityRelationship>();
+
+        JobSystem& jobSystem = JobSystem::getDefault();
+        size_t const chunkCount = std::clamp(subtreeRoots.size() / MIN_DESTROYED_SUBTREES_PER_JOB,
+                                             size_t {1},
+                                             jobSystem.getWorkerCount() + 1);
+        size_t const chunkSize = (subtreeRoots.size() + chunkCount - 1) / chunkCount;
+
+        std::vector<std::vector<Entity>> chunks(chunkCount);
+        jobSystem.parallelFor(
+            chunkCount,
+            1,
+            [&](size_t first, size_t last)
+            {
+                for (size_t chunk = first; chunk < last; chunk++)
+                {
+                    std::vector<Entity>& gathered = chunks[chunk];
+                    auto const begin = std::min(chunk * chunkSize, subtreeRoots.size());
+                    auto const end = std::min(begin + chunkSize, subtreeRoots.size());
+                    gathered.assign(subtreeRoots.begin() + begin, subtreeRoots.begin() + end);
+
+                    for (size_t i = 0; i < gathered.size(); i++)
+                    {
+                        const auto& relationship = relationships.get(gathered[i]);
+                        Entity child = relationship.firstChild;
+                        for (size_t c = 0; c < relationship.childCount; c++)
+                        {
+                            gathered.push_back(child);
+                            child = relationships.get(child).nextSibling;
+                        }
+                    }
+                }
+            });
+
+        std::vector<Entity> destroyed = std::move(chunks.front());
+        for (size_t chunk = 1; chunk < chunkCount; chunk++)
+        {
+            destroyed.insert(destroyed.end(), chunks[chunk].begin(), chunks[chunk].end());
+        }
+
+        // registry.destroy goes through every storage for each entity in turn; going storage by
+        // storage instead keeps each one's sparse and packed arrays in cache for the whole batch.
+        // Destroy signals still fire for every removed component.
+        for (auto&& [id, storage] : _registry.storage())
+        {
+            storage.remove(destroyed.begin(), destroyed.end());
+        }
+        _registry.release(destroyed.begin(), destroyed.end());
+
+        _depthFirstDirty = true;
+        return destroyed.size();
+    }
+
+    void Scene::detach(Entity entity, EntityRelationship& relationship) noexcept
+    {
         if (relationship.parent != entt::null)
         {
             auto& parentRelationship = getComponent<EntityRelationship>(relationship.parent);
@@ -61,109 +342,367 @@ namespace exage
             previousSiblingRelationship.nextSibling = relationship.nextSibling;
         }
 
-        size_t const childCount = relationship.childCount;
-        for (size_t i = 0; i < childCount; i++)
+        relationship.parent = entt::null;
+        relationship.nextSibling = entt::null;
+        relationship.previousSibling = entt::null;
+    }
+
+    void Scene::calculateChildTransform(Transform3D& parentTransform,
+                                        const glm::mat3& parentRotation,
+                                        Entity entity) noexcept
+    {
+        auto* childTransform = _registry.try_get<Transform3D>(entity);
+        if (childTransform != nullptr)
+        {
+            propagateChildTransform(parentTransform, parentRotation, *childTransform);
+        }
+
+        if (getComponent<EntityRelationship>(entity).childCount == 0)
         {
-            destroyEntity(relationship.firstChild);
+            return;
         }
 
-        _registry.destroy(entity);
+        // Converted once here rather than once per child
+        if (childTransform != nullptr)
+        {
+            glm::mat3 const rotation = childTransform->globalRotation.getRotationMatrix3();
+            forEachChild(entity,
+                         [&](Entity child)
+                         { calculateChildTransform(*childTransform, rotation, child); });
+            return;
+        }
+
+        forEachChild(entity,
+                     [&](Entity child)
+                     { calculateChildTransform(parentTransform, parentRotation, child); });
     }
 
-    void Scene::calculateChildTransform(Transform3D& parentTransform, Entity entity) noexcept
+    void Scene::calculateCompactTransform(const glm::mat4x3* parentWorld, Entity entity) noexcept
     {
-        Transform3D* newParent = &parentTransform;
+        glm::mat4x3 inherited;
 
-        if (hasComponent<Transform3D>(entity))
+        if (auto* compact = _registry.try_get<CompactTransform>(entity))
         {
-            auto& childTransform = getComponent<Transform3D>(entity);
-            glm::quat childRotation = childTransform.rotation.getQuaternion();
+            auto& world = getComponent<WorldTransform>(entity);
+            glm::mat4x3 local = composeAffineTransform(*compact);
+            world.matrix = parentWorld != nullptr ? multiplyAffine(*parentWorld, local) : local;
 
-            childTransform.globalRotation = parentTransform.globalRotation * childRotation;
-            childTransform.globalScale = parentTransform.globalScale * childTransform.scale;
+            parentWorld = &world.matrix;
+        }
+        else if (auto* transform = _registry.try_get<Transform3D>(entity))
+        {
+            inherited = glm::mat4x3 {transform->globalMatrix};
+            parentWorld = &inherited;
+        }
 
-            childTransform.matrix = calculateTransformMatrix(childTransform);
-            childTransform.globalMatrix = parentTransform.globalMatrix * childTransform.matrix;
+        forEachChild(entity,
+                     [&](Entity child) { calculateCompactTransform(parentWorld, child); });
+    }
 
-            childTransform.globalPosition = parentTransform.globalPosition
-                + glm::toMat3(parentTransform.globalRotation.getQuaternion())
-                    * (parentTransform.globalScale * childTransform.position);
+    void Scene::flattenHierarchy() noexcept
+    {
+        _flatTransforms.clear();
+        _flatLevels.clear();
 
-            newParent = &childTransform;
+        auto roots = _registry.view<EntityRelationship, Transform3D, RootEntity>();
+        for (auto entity : roots)
+        {
+            _flatTransforms.push_back({entity, &roots.get<Transform3D>(entity), nullptr});
         }
 
-        forEachChild(entity, [&](Entity child) { calculateChildTransform(*newParent, child); });
+        // Entities without a Transform3D are transparent: their children are parented to the
+        // closest ancestor that has one, exactly like calculateChildTransform does
+        std::vector<Entity> pending;
+
+        size_t levelBegin = 0;
+        while (levelBegin < _flatTransforms.size())
+        {
+            size_t const levelEnd = _flatTransforms.size();
+            _flatLevels.push_back(levelBegin);
+
+            for (size_t i = levelBegin; i < levelEnd; i++)
+            {
+                Entity const entity = _flatTransforms[i].entity;
+                const Transform3D* parent = _flatTransforms[i].transform;
+
+                pending.clear();
+                forEachChild(entity, [&](Entity child) { pending.push_back(child); });
+
+                while (!pending.empty())
+                {
+                    Entity const child = pending.back();
+                    pending.pop_back();
+
+                    if (auto* transform = _registry.try_get<Transform3D>(child))
+                    {
+                        _flatTransforms.push_back({child, transform, parent});
+                    }
+                    else
+                    {
+                        forEachChild(child,
+                                     [&](Entity grandChild) { pending.push_back(grandChild); });
+                    }
+                }
+            }
+
+            levelBegin = levelEnd;
+        }
+
+        _flatLevels.push_back(_flatTransforms.size());
+    }
+
+    void Scene::propagateFlattened() noexcept
+    {
+        flattenHierarchy();
+
+        JobSystem& jobSystem = JobSystem::getDefault();
+
+        // A level only reads the global data written by the previous one, so each level is split
+        // across the workers and joined before moving on
+        for (size_t level = 0; level + 1 < _flatLevels.size(); level++)
+        {
+            size_t const begin = _flatLevels[level];
+            size_t const count = _flatLevels[level + 1] - begin;
+
+            jobSystem.parallelFor(count,
+                                  MIN_FLAT_TRANSFORMS_PER_JOB,
+                                  [&](size_t first, size_t last)
+                                  {
+                                      // Siblings are contiguous within a level, so the parent's
+                                      // rotation is converted once per run of siblings
+                                      const Transform3D* parent = nullptr;
+                                      glm::mat3 parentRotation;
+
+                                      for (size_t i = begin + first; i < begin + last; i++)
+                                      {
+                                          FlatTransform& flat = _flatTransforms[i];
+
+                                          if (flat.parent == nullptr)
+                                          {
+                                              propagateRootTransform(*flat.transform);
+                                              continue;
+                                          }
+
+                                          if (flat.parent != parent)
+                                          {
+                                              parent = flat.parent;
+                                              parentRotation =
+                                                  parent->globalRotation.getRotationMatrix3();
+                                          }
+
+                                          propagateChildTransform(
+                                              *flat.parent, parentRotation, *flat.transform);
+                                      }
+                                  });
+        }
+    }
+
+    void Scene::markAllTransformsDirty() noexcept
+    {
+        _registry.clear<TransformDirty>();
+
+        auto view = _registry.view<Transform3D>();
+        _registry.insert<TransformDirty>(view.begin(), view.end());
+
+        auto compactView = _registry.view<CompactTransform>(entt::exclude<Transform3D>);
+        _registry.insert<TransformDirty>(compactView.begin(), compactView.end());
+    }
+
+    void Scene::calculateDirtyTransforms() noexcept
+    {
+        auto view = _registry.view<TransformDirty>();
+        for (auto entity : view)
+        {
+            // Find the closest transformed ancestor, unless an ancestor is dirty as well, in which
+            // case this entity gets recomputed as part of that ancestor's subtree
+            Transform3D* parentTransform = nullptr;
+            Entity top = entity;
+            bool covered = false;
+
+            Entity ancestor = getComponent<EntityRelationship>(entity).parent;
+            while (ancestor != entt::null)
+            {
+                if (hasComponent<TransformDirty>(ancestor))
+                {
+                    covered = true;
+                    break;
+                }
+
+                if (parentTransform == nullptr)
+                {
+                    parentTransform = _registry.try_get<Transform3D>(ancestor);
+                }
+
+                top = ancestor;
+                ancestor = getComponent<EntityRelationship>(ancestor).parent;
+            }
+
+            // A full update never descends into trees whose root has no transform
+            if (covered || !hasComponent<Transform3D>(top))
+            {
+                continue;
+            }
+
+            recordTransformChange(entity);
+
+            if (parentTransform != nullptr)
+            {
+                calculateChildTransform(
+                    *parentTransform, parentTransform->globalRotation.getRotationMatrix3(), entity);
+                continue;
+            }
+
+            auto& transform = getComponent<Transform3D>(entity);
+            propagateRootTransform(transform);
+
+            glm::mat3 const rotation = transform.globalRotation.getRotationMatrix3();
+            forEachChild(entity,
+                         [&](Entity child)
+                         { calculateChildTransform(transform, rotation, child); });
+        }
     }
 
     void Scene::updateHierarchy(bool calculateTransforms) noexcept
     {
+#if EXAGE_USE_ASSERTS
+        // RootEntity is maintained by createEntity and setParent; make sure nothing bypassed them
         auto view = _registry.view<EntityRelationship>();
         for (auto entity : view)
         {
             auto& relationship = view.get<EntityRelationship>(entity);
+            debugAssert((relationship.parent == entt::null) == hasComponent<RootEntity>(entity),
+                        "RootEntity tag out of sync with EntityRelationship::parent");
+        }
+#endif
 
-            if (relationship.parent == entt::null)
+        if (!calculateTransforms)
+        {
+            return;
+        }
+
+        // Marking an entity without a transform dirty recomputes its children from the closest
+        // transformed ancestor, as a full update would
+        for (Entity entity : *_removedTransforms)
+        {
+            if (_registry.valid(entity))
             {
-                _registry.emplace_or_replace<RootEntity>(entity);
+                markTransformDirty(entity);
             }
-            else
-            {
-                _registry.remove<RootEntity>(entity);
-            }  // All entities that have a parent are not root entities
+        }
+        _removedTransforms->clear();
+
+        size_t const dirtyCount = _registry.view<TransformDirty>().size();
+        if (dirtyCount == 0)
+        {
+            return;
+        }
+
+        size_t const transformCount = _registry.view<Transform3D>().size();
+        bool const hasCompact = !_registry.view<CompactTransform>().empty();
+        bool const fullPass = dirtyCount * FULL_UPDATE_DIRTY_DIVISOR >= transformCount;
+
+        // The compact pass always recomputes everything
+        if (fullPass || hasCompact)
+        {
+            recordAllTransformsChanged();
         }
 
-        if (calculateTransforms)
+        if (!fullPass)
+        {
+            calculateDirtyTransforms();
+        }
+        else if (_transformPropagation == TransformPropagation::eFlattened)
+        {
+            propagateFlattened();
+        }
+        else if (!tryPropagateDepthFirst())
         {
-            auto view = _registry.view<EntityRelationship, Transform3D, RootEntity>();
-            for (auto entity : view)
+            auto rootView = _registry.view<EntityRelationship, Transform3D, RootEntity>();
+            for (auto entity : rootView)
             {
-                auto& transform = view.get<Transform3D>(entity);
-                transform.globalRotation = transform.rotation;
-                transform.globalPosition = transform.position;
-                transform.globalScale = transform.scale;
-                transform.matrix = calculateTransformMatrix(transform);
-                transform.globalMatrix = transform.matrix;
+                auto& transform = rootView.get<Transform3D>(entity);
+                propagateRootTransform(transform);
 
+                glm::mat3 const rotation = transform.globalRotation.getRotationMatrix3();
                 forEachChild(entity,
-                             [&](Entity child) { calculateChildTransform(transform, child); });
+                             [&](Entity child)
+                             { calculateChildTransform(transform, rotation, child); });
             }
         }
+
+        // Compact transforms are derived after Transform3D, which they may be parented to
+        if (hasCompact)
+        {
+            forEachRoot([&](Entity root) { calculateCompactTransform(nullptr, root); });
+        }
+
+        _registry.clear<TransformDirty>();
     }
 
-    void Scene::setParent(Entity entity, Entity parent) noexcept
+    auto Scene::addTransformListener() noexcept -> TransformListener
     {
-        auto& relationship = getComponent<EntityRelationship>(entity);
+        auto free = std::find(_transformListeners.begin(), _transformListeners.end(), std::nullopt);
+        if (free == _transformListeners.end())
+        {
+            free = _transformListeners.emplace(_transformListeners.end());
+        }
 
-        if (relationship.parent != entt::null)
+        free->emplace();
+        return static_cast<TransformListener>(free - _transformListeners.begin());
+    }
+
+    void Scene::removeTransformListener(TransformListener listener) noexcept
+    {
+        debugAssume(listener < _transformListeners.size(), "Invalid transform listener");
+        _transformListeners[listener].reset();
+    }
+
+    void Scene::takeTransformChanges(TransformListener listener,
+                                     TransformChanges& changes) noexcept
+    {
+        debugAssume(listener < _transformListeners.size() && _transformListeners[listener],
+                    "Invalid transform listener");
+
+        TransformChanges& recorded = *_transformListeners[listener];
+        std::swap(changes, recorded);
+        recorded.all = false;
+        recorded.subtrees.clear();
+    }
+
+    void Scene::recordTransformChange(Entity subtree) noexcept
+    {
+        for (auto& changes : _transformListeners)
         {
-            auto& parentRelationship = getComponent<EntityRelationship>(relationship.parent);
-            parentRelationship.childCount--;
-            if (parentRelationship.firstChild == entity)
+            if (changes && !changes->all)
             {
-                parentRelationship.firstChild = relationship.nextSibling;
+                changes->subtrees.push_back(subtree);
             }
         }
+    }
 
-        if (relationship.nextSibling != entt::null)
+    void Scene::recordAllTransformsChanged() noexcept
+    {
+        for (auto& changes : _transformListeners)
         {
-            auto& nextSiblingRelationship =
-                getComponent<EntityRelationship>(relationship.nextSibling);
-            nextSiblingRelationship.previousSibling = relationship.previousSibling;
+            if (changes)
+            {
+                changes->all = true;
+                changes->subtrees.clear();
+            }
         }
+    }
 
-        if (relationship.previousSibling != entt::null)
-        {
-            auto& previousSiblingRelationship =
-                getComponent<EntityRelationship>(relationship.previousSibling);
-            previousSiblingRelationship.nextSibling = relationship.nextSibling;
-        }
+    void Scene::setParent(Entity entity, Entity parent) noexcept
+    {
+        auto& relationship = getComponent<EntityRelationship>(entity);
 
+        detach(entity, relationship);
         relationship.parent = parent;
-        relationship.nextSibling = entt::null;
-        relationship.previousSibling = entt::null;
 
         if (parent != entt::null)
         {
+            _registry.remove<RootEntity>(entity);
+
             auto& parentRelationship = getComponent<EntityRelationship>(parent);
 
             if (parentRelationship.firstChild != entt::null)
@@ -178,5 +717,160 @@ namespace exage
             parentRelationship.firstChild = entity;
             parentRelationship.childCount++;
         }
+        else
+        {
+            _registry.emplace_or_replace<RootEntity>(entity);
+        }
+
+        _depthFirstDirty = true;
+        markTransformDirty(entity);
+    }
+
+    auto Scene::acquireDepthFirst() noexcept -> bool
+    {
+        if (_hierarchyStorage != HierarchyStorage::eDepthFirst)
+        {
+            return false;
+        }
+
+        if (_depthFirstDirty)
+        {
+            // Re-sorting under a running traversal would move the arrays it is reading
+            if (_depthFirstUsers > 0)
+            {
+                return false;
+            }
+
+            sortDepthFirst();
+        }
+
+        _depthFirstUsers++;
+        return true;
+    }
+
+    void Scene::sortDepthFirst() noexcept
+    {
+        constexpr uint32_t NO_INDEX = DepthFirstHierarchy::NO_INDEX;
+
+        auto& hierarchy = _depthFirst;
+        hierarchy.entities.clear();
+        hierarchy.parents.clear();
+        hierarchy.subtreeEnds.clear();
+        std::fill(hierarchy.indices.begin(), hierarchy.indices.end(), NO_INDEX);
+
+        auto append = [&](Entity entity, uint32_t parent) -> uint32_t
+        {
+            auto const index = static_cast<uint32_t>(hierarchy.entities.size());
+            hierarchy.entities.push_back(entity);
+            hierarchy.parents.push_back(parent);
+            hierarchy.subtreeEnds.push_back(NO_INDEX);
+
+            auto const id = static_cast<size_t>(entt::to_entity(entity));
+            if (id >= hierarchy.indices.size())
+            {
+                hierarchy.indices.resize(id + 1, NO_INDEX);
+            }
+            hierarchy.indices[id] = index;
+            return index;
+        };
+
+        // Pre-order walk over the sibling links, so children keep their linked-list order
+        auto roots = _registry.view<RootEntity>();
+        for (auto root : roots)
+        {
+            Entity current = root;
+            uint32_t parent = NO_INDEX;
+
+            while (current != entt::null)
+            {
+                uint32_t index = append(current, parent);
+                const auto& relationship = getComponent<EntityRelationship>(current);
+
+                if (relationship.childCount > 0)
+                {
+                    parent = index;
+                    current = relationship.firstChild;
+                    continue;
+                }
+
+                // Close finished subtrees until one of them has a next sibling
+                current = entt::null;
+                while (index != NO_INDEX)
+                {
+                    hierarchy.subtreeEnds[index] = static_cast<uint32_t>(hierarchy.entities.size());
+
+                    Entity sibling = hierarchy.parents[index] == NO_INDEX
+                        ? Entity {entt::null}
+                        : getComponent<EntityRelationship>(hierarchy.entities[index]).nextSibling;
+                    if (sibling != entt::null)
+                    {
+                        current = sibling;
+                        parent = hierarchy.parents[index];
+                        break;
+                    }
+
+                    index = hierarchy.parents[index];
+                }
+            }
+        }
+
+        _depthFirstDirty = false;
+    }
+
+    auto Scene::tryPropagateDepthFirst() noexcept -> bool
+    {
+        if (!acquireDepthFirst())
+        {
+            return false;
+        }
+
+        auto const count = static_cast<uint32_t>(_depthFirst.entities.size());
+        _depthFirstTransforms.resize(count);
+        _depthFirstRotations.resize(count);
+
+        // Parents always precede their children, so one forward pass sees every parent finished
+        for (uint32_t i = 0; i < count;)
+        {
+            Entity entity = _depthFirst.entities[i];
+            auto* transform = _registry.try_get<Transform3D>(entity);
+            uint32_t const parent = _depthFirst.parents[i];
+            bool const hasChildren = _depthFirst.subtreeEnds[i] > i + 1;
+
+            if (parent == DepthFirstHierarchy::NO_INDEX)
+            {
+                // Trees without a transformed root are skipped, like the recursive path does
+                if (transform == nullptr)
+                {
+                    i = _depthFirst.subtreeEnds[i];
+                    continue;
+                }
+
+                propagateRootTransform(*transform);
+                _depthFirstTransforms[i] = transform;
+            }
+            else if (transform != nullptr)
+            {
+                propagateChildTransform(
+                    *_depthFirstTransforms[parent], _depthFirstRotations[parent], *transform);
+                _depthFirstTransforms[i] = transform;
+            }
+            else
+            {
+                _depthFirstTransforms[i] = _depthFirstTransforms[parent];
+            }
+
+            // Converted once per parent rather than once per child
+            if (hasChildren)
+            {
+                _depthFirstRotations[i] = transform != nullptr
+                    ? transform->globalRotation.getRotationMatrix3()
+                    : _depthFirstRotations[parent];
+            }
+
+            i++;
+        }
+
+        _depthFirstUsers--;
+        return true;
     }
 }  // namespace exage
@@ -0,0 +1,190 @@
+#include <algorithm>
+#include <array>
+#include <cstddef>
+
+#include "Core/SimdLanes.h"
+#include "exage/Core/Debug.h"
+#include "exage/Scene/Hierarchy.h"
+
+namespace exage
+{
+    namespace
+    {
+        struct TRS
+        {
+            glm::vec3 position;
+            glm::quat rotation;
+            glm::vec3 scale;
+        };
+
+#if EXAGE_SIMD
+        using namespace detail;
+
+        // One batch of transforms in structure-of-arrays form
+        struct Batch
+        {
+            enum Channel : size_t
+            {
+                ePositionX,
+                ePositionY,
+                ePositionZ,
+                eRotationX,
+                eRotationY,
+                eRotationZ,
+                eRotationW,
+                eScaleX,
+                eScaleY,
+                eScaleZ,
+                eCount,
+            };
+
+            alignas(32) std::array<std::array<float, LANE_COUNT>, eCount> in;
+            alignas(32) std::array<std::array<float, LANE_COUNT>, 9> out;  // Scaled 3x3, by column
+
+            void set(size_t lane, glm::vec3 position, glm::quat rotation, glm::vec3 scale) noexcept
+            {
+                in[ePositionX][lane] = position.x;
+                in[ePositionY][lane] = position.y;
+                in[ePositionZ][lane] = position.z;
+                in[eRotationX][lane] = rotation.x;
+                in[eRotationY][lane] = rotation.y;
+                in[eRotationZ][lane] = rotation.z;
+                in[eRotationW][lane] = rotation.w;
+                in[eScaleX][lane] = scale.x;
+                in[eScaleY][lane] = scale.y;
+                in[eScaleZ][lane] = scale.z;
+            }
+
+            // Same operations in the same order as composeTransformMatrix, one lane per transform
+            void compose() noexcept
+            {
+                Lanes const x = loadLanes(in[eRotationX].data());
+                Lanes const y = loadLanes(in[eRotationY].data());
+                Lanes const z = loadLanes(in[eRotationZ].data());
+                Lanes const w = loadLanes(in[eRotationW].data());
+
+                Lanes const qxx = mul(x, x);
+                Lanes const qyy = mul(y, y);
+                Lanes const qzz = mul(z, z);
+                Lanes const qxz = mul(x, z);
+                Lanes const qxy = mul(x, y);
+                Lanes const qyz = mul(y, z);
+                Lanes const qwx = mul(w, x);
+                Lanes const qwy = mul(w, y);
+                Lanes const qwz = mul(w, z);
+
+                Lanes const one = splat(1.F);
+                Lanes const two = splat(2.F);
+
+                Lanes const scaleX = loadLanes(in[eScaleX].data());
+                Lanes const scaleY = loadLanes(in[eScaleY].data());
+                Lanes const scaleZ = loadLanes(in[eScaleZ].data());
+
+                storeLanes(out[0].data(), mul(sub(one, mul(two, add(qyy, qzz))), scaleX));
+                storeLanes(out[1].data(), mul(mul(two, add(qxy, qwz)), scaleX));
+                storeLanes(out[2].data(), mul(mul(two, sub(qxz, qwy)), scaleX));
+                storeLanes(out[3].data(), mul(mul(two, sub(qxy, qwz)), scaleY));
+                storeLanes(out[4].data(), mul(sub(one, mul(two, add(qxx, qzz))), scaleY));
+                storeLanes(out[5].data(), mul(mul(two, add(qyz, qwx)), scaleY));
+                storeLanes(out[6].data(), mul(mul(two, add(qxz, qwy)), scaleZ));
+                storeLanes(out[7].data(), mul(mul(two, sub(qyz, qwx)), scaleZ));
+                storeLanes(out[8].data(), mul(sub(one, mul(two, add(qxx, qyy))), scaleZ));
+            }
+
+            // Transposes four lanes at a time back into column-major matrices
+            template<typename Store>
+            void write(size_t first, size_t count, Store& store) const noexcept
+            {
+                for (size_t block = 0; block < count; block += 4)
+                {
+                    size_t const lanes = std::min<size_t>(4, count - block);
+
+                    auto writeColumn = [&](size_t column, __m128 x, __m128 y, __m128 z, __m128 w)
+                    {
+                        _MM_TRANSPOSE4_PS(x, y, z, w);
+                        __m128 const transposed[] = {x, y, z, w};  // NOLINT(*-avoid-c-arrays)
+
+                        for (size_t lane = 0; lane < lanes; lane++)
+                        {
+                            glm::mat4& matrix = store(first + block + lane);
+                            _mm_storeu_ps(&matrix[static_cast<glm::length_t>(column)][0],
+                                          transposed[lane]);
+                        }
+                    };
+
+                    for (size_t column = 0; column < 3; column++)
+                    {
+                        writeColumn(column,
+                                    _mm_load_ps(&out[column * 3][block]),
+                                    _mm_load_ps(&out[column * 3 + 1][block]),
+                                    _mm_load_ps(&out[column * 3 + 2][block]),
+                                    _mm_setzero_ps());
+                    }
+
+                    writeColumn(3,
+                                _mm_load_ps(&in[ePositionX][block]),
+                                _mm_load_ps(&in[ePositionY][block]),
+                                _mm_load_ps(&in[ePositionZ][block]),
+                                _mm_set1_ps(1.F));
+                }
+            }
+        };
+#endif
+
+        // Load returns {position, rotation, scale} for an index, Store the matrix to write
+        template<typename Load, typename Store>
+        void composeBatched(size_t count, Load load, Store store) noexcept
+        {
+            size_t i = 0;
+
+#if EXAGE_SIMD
+            Batch batch;
+            for (; i + LANE_COUNT <= count; i += LANE_COUNT)
+            {
+                for (size_t lane = 0; lane < LANE_COUNT; lane++)
+                {
+                    auto [position, rotation, scale] = load(i + lane);
+                    batch.set(lane, position, rotation, scale);
+                }
+
+                batch.compose();
+                batch.write(i, LANE_COUNT, store);
+            }
+#endif
+
+            for (; i < count; i++)
+            {
+                auto [position, rotation, scale] = load(i);
+                store(i) = composeTransformMatrix(position, rotation, scale);
+            }
+        }
+    }  // namespace
+
+    void composeTransformMatrices(std::span<const glm::vec3> positions,
+                                  std::span<const glm::quat> rotations,
+                                  std::span<const glm::vec3> scales,
+                                  std::span<glm::mat4> matrices) noexcept
+    {
+        debugAssume(positions.size() == matrices.size() && rotations.size() == matrices.size()
+                        && scales.size() == matrices.size(),
+                    "Transform component spans differ in size");
+
+        composeBatched(
+            matrices.size(),
+            [&](size_t i) { return TRS {positions[i], rotations[i], scales[i]}; },
+            [&](size_t i) -> glm::mat4& { return matrices[i]; });
+    }
+
+    void calculateTransformMatrices(std::span<Transform3D> transforms) noexcept
+    {
+        composeBatched(
+            transforms.size(),
+            [&](size_t i)
+            {
+                const auto& transform = transforms[i];
+                return TRS {
+                    transform.position, transform.rotation.getQuaternion(), transform.scale};
+            },
+            [&](size_t i) -> glm::mat4& { return transforms[i].matrix; });
+    }
+}  // namespace exage
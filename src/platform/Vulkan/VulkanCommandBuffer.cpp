@@ -1,7 +1,9 @@
-﻿#include <mutex>
+﻿#include <memory_resource>
+#include <mutex>
 
 #include "exage/platform/Vulkan/VulkanCommandBuffer.h"
 
+#include "exage/Core/FrameArena.h"
 #include "exage/Graphics/Commands.h"
 #include "exage/Graphics/Texture.h"
 #include "exage/platform/Vulkan/VulkanBuffer.h"
@@ -203,7 +205,7 @@ namespace exage::Graphics
     }
 
     void VulkanCommandBuffer::beginRendering(std::shared_ptr<FrameBuffer> frameBuffer,
-                                             std::vector<ClearColor> clearColors,
+                                             std::span<const ClearColor> clearColors,
                                              ClearDepthStencil clearDepth) noexcept
     {
         debugAssume(frameBuffer->getTextures().size() == clearColors.size(),
@@ -211,10 +213,10 @@ namespace exage::Graphics
 
         BeginRenderingCommand beginRenderingCommand;
         beginRenderingCommand.frameBuffer = frameBuffer;
-        beginRenderingCommand.clearColors = clearColors;
+        beginRenderingCommand.clearColors = FrameArena::get().copy(clearColors);
         beginRenderingCommand.clearDepth = clearDepth;
 
-        _commands.emplace_back(beginRenderingCommand);
+        _commands.emplace_back(std::move(beginRenderingCommand));
     }
 
     void VulkanCommandBuffer::endRendering() noexcept
@@ -373,13 +375,9 @@ namespace exage::Graphics
         _commands.emplace_back(bindStorageTextureCommand);
     }
 
-    void VulkanCommandBuffer::userDefined(
-        std::function<void(CommandBuffer&)> commandFunction) noexcept
+    void VulkanCommandBuffer::recordUserDefined(UserDefinedCommand command) noexcept
     {
-        UserDefinedCommand userDefinedCommand;
-        userDefinedCommand.commandFunction = commandFunction;
-
-        _commands.emplace_back(userDefinedCommand);
+        _commands.emplace_back(command);
     }
 
     void VulkanCommandBuffer::processCommand(const GPUCommand& command) noexcept
@@ -494,7 +492,7 @@ namespace exage::Graphics
                                              &imageBlit,
                                              vk::Filter::eLinear);
                 },
-                [this](const UserDefinedCommand& cmd) { cmd.commandFunction(*this); },
+                [this](const UserDefinedCommand& cmd) { cmd.invoke(cmd.function, *this); },
                 [this](const SetViewportCommand& cmd)
                 {
                     // negative height to flip the viewport
@@ -560,7 +558,7 @@ namespace exage::Graphics
                         vk::Rect2D {vk::Offset2D {0, 0}, vk::Extent2D {extent.x, extent.y}};
                     renderingInfo.layerCount = 1;
 
-                    std::vector<vk::RenderingAttachmentInfo> info;
+                    std::pmr::vector<vk::RenderingAttachmentInfo> info {&FrameArena::get()};
                     info.reserve(textures.size());
 
                     for (size_t i = 0; i < textures.size(); i++)
@@ -626,10 +624,12 @@ namespace exage::Graphics
                     auto& srcBuffer = *cmd.srcBuffer->as<VulkanBuffer>();
                     auto& dstTexture = *cmd.dstTexture->as<VulkanTexture>();
 
+                    // Tightly packed; a row length of extent.x is invalid for block-compressed
+                    // mips narrower than a block
                     vk::BufferImageCopy copy {};
                     copy.bufferOffset = cmd.srcOffset;
-                    copy.bufferRowLength = cmd.extent.x;
-                    copy.bufferImageHeight = cmd.extent.y;
+                    copy.bufferRowLength = 0;
+                    copy.bufferImageHeight = 0;
                     copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
                     copy.imageSubresource.mipLevel = cmd.dstMipLevel;
                     copy.imageSubresource.baseArrayLayer = cmd.dstFirstLayer;
@@ -653,8 +653,8 @@ namespace exage::Graphics
 
                     vk::BufferImageCopy copy {};
                     copy.bufferOffset = cmd.dstOffset;
-                    copy.bufferRowLength = cmd.extent.x;
-                    copy.bufferImageHeight = cmd.extent.y;
+                    copy.bufferRowLength = 0;
+                    copy.bufferImageHeight = 0;
 
                     copy.imageSubresource.aspectMask = vk::ImageAspectFlagBits::eColor;
                     copy.imageSubresource.mipLevel = cmd.srcMipLevel;
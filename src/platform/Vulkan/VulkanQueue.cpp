@@ -1,5 +1,6 @@
 ﻿#include "exage/platform/Vulkan/VulkanQueue.h"
 
+#include "exage/Core/FrameArena.h"
 #include "exage/Graphics/CommandBuffer.h"
 #include "exage/Graphics/Error.h"
 #include "exage/Graphics/Swapchain.h"
@@ -89,6 +90,9 @@ namespace exage::Graphics
         result = _context.get().getDevice().resetFences(1, &_renderFences[_currentFrame]);
         checkVulkan(result);
 
+        // What was recorded for this frame the last time around is no longer in use
+        FrameArena::startFrame(_currentFrame);
+
         _context.get().processDeletions(_currentFrame);
     }
 
@@ -123,8 +123,7 @@ namespace exage::Graphics
 
         bool const transitioned = _swapchainTransitioned[_currentImage];
 
-        std::function const commandFunction =
-            [this, vulkanTexture, transitioned](CommandBuffer& cmd)
+        auto const commandFunction = [this, vulkanTexture, transitioned](CommandBuffer& cmd)
         {
             const auto* vulkanCommandBuffer = cmd.as<VulkanCommandBuffer>();
             const vk::CommandBuffer vkCommand = vulkanCommandBuffer->getCommandBuffer();
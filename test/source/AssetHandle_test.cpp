@@ -0,0 +1,65 @@
+#include <set>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/AssetHandle.h"
+
+using namespace exage::Renderer;
+
+TEST_CASE("Asset paths are interned once", "[Renderer]")
+{
+    AssetHandle const mesh = internAsset("handles/mesh.exmesh");
+    AssetHandle const texture = internAsset("handles/texture.extex");
+
+    REQUIRE(mesh.isValid());
+    REQUIRE(mesh != texture);
+    REQUIRE(internAsset(std::string {"handles/mesh.exmesh"}) == mesh);
+    REQUIRE(findAsset("handles/mesh.exmesh") == mesh);
+    REQUIRE(getAssetPath(mesh) == "handles/mesh.exmesh");
+
+    REQUIRE_FALSE(findAsset("handles/never-interned.exmesh").isValid());
+    REQUIRE(getAssetPath(AssetHandle {}).empty());
+}
+
+TEST_CASE("Asset paths interned from several threads agree", "[Renderer]")
+{
+    constexpr size_t THREAD_COUNT = 4;
+    constexpr size_t PATH_COUNT = 256;
+
+    std::vector<std::vector<AssetHandle>> handles(THREAD_COUNT);
+    std::vector<std::thread> threads;
+
+    for (size_t t = 0; t < THREAD_COUNT; t++)
+    {
+        threads.emplace_back(
+            [&, t]
+            {
+                for (size_t i = 0; i < PATH_COUNT; i++)
+                {
+                    handles[t].push_back(internAsset("threads/" + std::to_string(i)));
+                }
+            });
+    }
+
+    for (std::thread& thread : threads)
+    {
+        thread.join();
+    }
+
+    std::set<uint32_t> distinct;
+    for (size_t i = 0; i < PATH_COUNT; i++)
+    {
+        for (size_t t = 1; t < THREAD_COUNT; t++)
+        {
+            REQUIRE(handles[t][i] == handles[0][i]);
+        }
+
+        REQUIRE(getAssetPath(handles[0][i]) == "threads/" + std::to_string(i));
+        distinct.insert(handles[0][i].index);
+    }
+
+    REQUIRE(distinct.size() == PATH_COUNT);
+}
@@ -0,0 +1,178 @@
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/BoundingVolumeHierarchy.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    constexpr size_t ENTITY_COUNT = 2000;
+
+    auto makeEntity(size_t index) -> Entity
+    {
+        return static_cast<Entity>(static_cast<uint32_t>(index));
+    }
+
+    auto makeBox(glm::vec3 position, glm::vec3 size) -> AABB
+    {
+        return {glm::vec4 {position, 0.F}, glm::vec4 {position + size, 0.F}};
+    }
+
+    // Entry distance of a ray into a box, or infinity if it misses
+    auto raycast(const AABB& box, glm::vec3 origin, glm::vec3 direction) -> float
+    {
+        glm::vec3 const t1 = (glm::vec3 {box.min} - origin) / direction;
+        glm::vec3 const t2 = (glm::vec3 {box.max} - origin) / direction;
+        glm::vec3 const entries = glm::min(t1, t2);
+        glm::vec3 const exits = glm::max(t1, t2);
+
+        float const entry = std::max({entries.x, entries.y, entries.z, 0.F});
+        float const exit = std::min({exits.x, exits.y, exits.z});
+        return entry <= exit ? entry : std::numeric_limits<float>::infinity();
+    }
+
+    // Random boxes, some of them moved, replaced or removed, checked against a brute force scan
+    struct Fixture
+    {
+        std::mt19937 random {42};
+        std::vector<AABB> boxes;
+        std::vector<bool> alive;
+        BoundingVolumeHierarchy hierarchy;
+
+        Fixture()
+        {
+            for (size_t i = 0; i < ENTITY_COUNT; i++)
+            {
+                boxes.push_back(randomBox());
+                alive.push_back(true);
+                hierarchy.update(makeEntity(i), boxes[i]);
+            }
+
+            std::uniform_int_distribution<size_t> pick {0, ENTITY_COUNT - 1};
+            for (size_t change = 0; change < ENTITY_COUNT; change++)
+            {
+                size_t const i = pick(random);
+
+                if (change % 3 == 0)
+                {
+                    hierarchy.remove(makeEntity(i));
+                    alive[i] = false;
+                    continue;
+                }
+
+                if (change % 3 == 1)
+                {
+                    boxes[i].min += glm::vec4 {0.05F, 0.F, 0.F, 0.F};
+                    boxes[i].max += glm::vec4 {0.05F, 0.F, 0.F, 0.F};
+                }
+                else
+                {
+                    boxes[i] = randomBox();
+                }
+
+                hierarchy.update(makeEntity(i), boxes[i]);
+                alive[i] = true;
+            }
+        }
+
+        auto randomBox() -> AABB
+        {
+            std::uniform_real_distribution<float> position {-100.F, 100.F};
+            std::uniform_real_distribution<float> size {0.1F, 4.F};
+            return makeBox(glm::vec3(position(random), position(random), position(random)),
+                           glm::vec3(size(random), size(random), size(random)));
+        }
+    };
+}  // namespace
+
+TEST_CASE("Bounding volume hierarchy stays balanced and keeps every entity", "[Renderer]")
+{
+    Fixture fixture;
+
+    size_t const aliveCount = std::count(fixture.alive.begin(), fixture.alive.end(), true);
+    REQUIRE(fixture.hierarchy.size() == aliveCount);
+
+    // An AVL-balanced tree is at most about 1.44 log2(n) high
+    REQUIRE(fixture.hierarchy.getHeight() <= 2 * 11);
+
+    for (size_t i = 0; i < ENTITY_COUNT; i++)
+    {
+        REQUIRE(fixture.hierarchy.contains(makeEntity(i)) == fixture.alive[i]);
+        if (fixture.alive[i])
+        {
+            REQUIRE(encloses(fixture.hierarchy.getFatBounds(makeEntity(i)), fixture.boxes[i]));
+        }
+    }
+}
+
+TEST_CASE("Bounding volume hierarchy queries match a linear scan", "[Renderer]")
+{
+    Fixture fixture;
+
+    SECTION("Overlap")
+    {
+        AABB const query = makeBox(glm::vec3(-20.F), glm::vec3(40.F));
+
+        std::vector<bool> reported(ENTITY_COUNT, false);
+        fixture.hierarchy.queryOverlap(
+            query, [&](Entity entity) { reported[static_cast<size_t>(entity)] = true; });
+
+        for (size_t i = 0; i < ENTITY_COUNT; i++)
+        {
+            if (fixture.alive[i] && overlaps(fixture.boxes[i], query))
+            {
+                REQUIRE(reported[i]);
+            }
+            if (reported[i])
+            {
+                REQUIRE(fixture.alive[i]);
+            }
+        }
+    }
+
+    SECTION("Closest ray hit")
+    {
+        for (size_t ray = 0; ray < 32; ray++)
+        {
+            // Aim at a live entity so that most rays hit something
+            size_t target = ray * 61 % ENTITY_COUNT;
+            while (!fixture.alive[target])
+            {
+                target = (target + 1) % ENTITY_COUNT;
+            }
+
+            glm::vec3 const origin = glm::vec3 {fixture.boxes[target].min}
+                + glm::vec3(0.05F, 0.05F, -300.F);
+            glm::vec3 const direction {0.F, 0.F, 1.F};
+
+            float expected = std::numeric_limits<float>::infinity();
+            for (size_t i = 0; i < ENTITY_COUNT; i++)
+            {
+                if (fixture.alive[i])
+                {
+                    expected = std::min(expected, raycast(fixture.boxes[i], origin, direction));
+                }
+            }
+
+            float closest = std::numeric_limits<float>::infinity();
+            fixture.hierarchy.queryRay(origin,
+                                       direction,
+                                       std::numeric_limits<float>::max(),
+                                       [&](Entity entity, float /*entryDistance*/)
+                                       {
+                                           auto const i = static_cast<size_t>(entity);
+                                           float const distance =
+                                               raycast(fixture.boxes[i], origin, direction);
+                                           closest = std::min(closest, distance);
+                                           return closest;
+                                       });
+
+            REQUIRE(closest == expected);
+        }
+    }
+}
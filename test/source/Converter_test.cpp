@@ -0,0 +1,277 @@
+#include <cmath>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <variant>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/Loader/Converter.h"
+#include "exage/Renderer/Scene/Loader/Loader.h"
+#include "exage/Renderer/Scene/VertexPacking.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    // A binary PPM of a diagonal gradient, which the converter reads like any other image
+    void saveTestImage(const std::filesystem::path& path, uint32_t size)
+    {
+        std::ofstream file(path, std::ios::binary);
+        file << "P6\n" << size << ' ' << size << "\n255\n";
+        for (uint32_t y = 0; y < size; y++)
+        {
+            for (uint32_t x = 0; x < size; x++)
+            {
+                auto const value = static_cast<char>((x + y) * 255 / (2 * size - 2));
+                file.put(value).put(value).put(static_cast<char>(255 - value));
+            }
+        }
+        REQUIRE(file.good());
+    }
+
+    auto makeImports(const std::filesystem::path& directory, size_t count)
+        -> std::vector<TextureImport>
+    {
+        std::filesystem::create_directories(directory);
+
+        std::vector<TextureImport> imports;
+        for (size_t i = 0; i < count; i++)
+        {
+            std::string const name = "Converter_test_" + std::to_string(i);
+            saveTestImage(directory / (name + ".ppm"), 16);
+            imports.push_back(TextureImport {
+                .sourcePath = directory / (name + ".ppm"),
+                .savePath = directory / (name + std::string(TEXTURE_EXTENSION)),
+                .path = name,
+            });
+        }
+        return imports;
+    }
+}  // namespace
+
+TEST_CASE("Imported 8-bit textures are RGBA and top-down", "[Converter]")
+{
+    std::filesystem::path const path =
+        std::filesystem::temp_directory_path() / "Converter_orientation_test.ppm";
+
+    // Odd widths leave a tail for the scalar loop after the vector ones
+    for (uint32_t size : {16U, 37U})
+    {
+        saveTestImage(path, size);
+
+        tl::expected<Texture, Error> const texture =
+            importTexture(path, MipGenerationOptions {.maxLevels = 1});
+        REQUIRE(texture.has_value());
+        REQUIRE(texture->channels == 4);
+        REQUIRE(texture->data.size() == static_cast<size_t>(size) * size * 4);
+
+        auto texel = [&](uint32_t x, uint32_t y, uint32_t channel)
+        {
+            return static_cast<uint8_t>(texture->data[(static_cast<size_t>(y) * size + x) * 4
+                                                      + channel]);
+        };
+
+        // saveTestImage starts out blue in the top left corner and ends up yellow
+        CHECK(texel(0, 0, 0) == 0);
+        CHECK(texel(0, 0, 2) == 255);
+        CHECK(texel(size - 1, size - 1, 0) == 255);
+        CHECK(texel(size - 1, size - 1, 1) == 255);
+        CHECK(texel(size - 1, size - 1, 2) == 0);
+
+        for (uint32_t x = 0; x < size; x++)
+        {
+            CHECK(texel(x, 0, 0) == texel(0, x, 1));
+            CHECK(texel(x, size - 1, 3) == 255);
+        }
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Imported UVs sample imported textures the right way up", "[Converter]")
+{
+    std::filesystem::path const directory =
+        std::filesystem::temp_directory_path() / "Converter_uv_test";
+    std::filesystem::create_directories(directory);
+
+    constexpr uint32_t SIZE = 16;
+    saveTestImage(directory / "texture.ppm", SIZE);
+
+    // A unit quad facing +z, textured the usual way with v = 0 along its bottom edge
+    {
+        std::ofstream file(directory / "quad.obj");
+        file << "v 0 0 0\nv 1 0 0\nv 1 1 0\nv 0 1 0\n"
+             << "vt 0 0\nvt 1 0\nvt 1 1\nvt 0 1\n"
+             << "f 1/1 2/2 3/3\nf 1/1 3/3 4/4\n";
+        REQUIRE(file.good());
+    }
+
+    tl::expected<AssetImportResult2, Error> const asset = importAsset2(directory / "quad.obj");
+    REQUIRE(asset.has_value());
+    REQUIRE(asset->meshes.size() == 1);
+
+    tl::expected<Texture, Error> const texture =
+        importTexture(directory / "texture.ppm", MipGenerationOptions {.maxLevels = 1});
+    REQUIRE(texture.has_value());
+
+    // Nearest texel, in the same top-down rows the renderer uploads
+    auto sample = [&](glm::vec2 uv, uint32_t channel)
+    {
+        auto const x = static_cast<uint32_t>(std::lround(uv.x * (SIZE - 1)));
+        auto const y = static_cast<uint32_t>(std::lround(uv.y * (SIZE - 1)));
+        return static_cast<uint8_t>(texture->data[(static_cast<size_t>(y) * SIZE + x) * 4
+                                                  + channel]);
+    };
+
+    // saveTestImage is blue in its top left corner and yellow in the bottom right one
+    size_t checked = 0;
+    for (const StaticMeshVertex& vertex : asset->meshes[0].vertices)
+    {
+        glm::vec2 const uv {vertex.uv.x, vertex.uv.y};
+        if (vertex.position.x == 0.F && vertex.position.y == 1.F)
+        {
+            CHECK(sample(uv, 2) == 255);
+            checked++;
+        }
+        else if (vertex.position.x == 1.F && vertex.position.y == 0.F)
+        {
+            CHECK(sample(uv, 0) == 255);
+            CHECK(sample(uv, 2) == 0);
+            checked++;
+        }
+    }
+    CHECK(checked == 2);
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Textures are imported in parallel with progress", "[Converter]")
+{
+    std::filesystem::path const directory =
+        std::filesystem::temp_directory_path() / "Converter_test";
+    std::vector<TextureImport> imports = makeImports(directory, 6);
+    imports[2].sourcePath = directory / "Converter_missing.ppm";
+
+    ImportProgress progress;
+    std::vector<tl::expected<void, Error>> const results = importTextures(imports, &progress);
+
+    REQUIRE(results.size() == imports.size());
+    CHECK(progress.getTotalSteps() > 0);
+    CHECK(progress.getCompletedSteps() == progress.getTotalSteps());
+
+    for (size_t i = 0; i < imports.size(); i++)
+    {
+        INFO("Texture " << i);
+
+        if (i == 2)
+        {
+            CHECK_FALSE(results[i].has_value());
+            CHECK_FALSE(std::filesystem::exists(imports[i].savePath));
+            continue;
+        }
+
+        REQUIRE(results[i].has_value());
+
+        tl::expected<Texture, Error> const texture = loadTexture(imports[i].savePath);
+        REQUIRE(texture.has_value());
+        CHECK(texture->path == imports[i].path);
+        CHECK(texture->mips.size() == 5);
+        CHECK(texture->compressedFormat == Graphics::Format::eBC7RGBA8);
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Cancelled imports stop before doing any work", "[Converter]")
+{
+    std::filesystem::path const directory =
+        std::filesystem::temp_directory_path() / "Converter_cancelled_test";
+    std::vector<TextureImport> const imports = makeImports(directory, 3);
+
+    ImportProgress progress;
+    progress.cancel();
+
+    for (const tl::expected<void, Error>& result : importTextures(imports, &progress))
+    {
+        REQUIRE_FALSE(result.has_value());
+        CHECK(std::holds_alternative<Errors::Cancelled>(result.error()));
+    }
+    for (const TextureImport& import : imports)
+    {
+        CHECK_FALSE(std::filesystem::exists(import.savePath));
+    }
+
+    std::filesystem::remove_all(directory);
+}
+
+TEST_CASE("Meshes are saved and loaded in their vertex format", "[Converter]")
+{
+    std::filesystem::path const path =
+        std::filesystem::temp_directory_path() / ("Converter_test" + std::string(MESH_EXTENSION));
+
+    StaticMesh original {};
+    original.path = "mesh";
+    original.lodCount = 1;
+    original.lods[0] = {3, 3, 0, 0};
+    original.aabb = {glm::vec4(-1.F, -1.F, 0.F, 1.F), glm::vec4(1.F, 1.F, 0.F, 1.F)};
+    original.indices = {0, 1, 2};
+    for (float const x : {-1.F, 1.F, 0.F})
+    {
+        StaticMeshVertex vertex {};
+        vertex.position = glm::vec4(x, x * x * 2.F - 1.F, 0.F, 1.F);
+        vertex.normal = glm::vec4(0.F, 0.F, 1.F, 0.F);
+        vertex.tangent = glm::vec4(1.F, 0.F, 0.F, 0.F);
+        vertex.bitangent = glm::vec4(0.F, 1.F, 0.F, 0.F);
+        vertex.uv = glm::vec4(x, 0.5F, 0.F, 0.F);
+        original.vertices.push_back(vertex);
+    }
+
+    for (VertexFormat format : {VertexFormat::eFull, VertexFormat::eQuantized})
+    {
+        StaticMesh mesh = original;
+        packVertices(mesh, format);
+        REQUIRE(saveMesh(mesh, path).has_value());
+
+        tl::expected<StaticMesh, Error> loaded = loadMesh(path);
+        REQUIRE(loaded.has_value());
+        CHECK(loaded->vertexFormat == format);
+        CHECK(loaded->packedVertices == mesh.packedVertices);
+        CHECK(loaded->indices == original.indices);
+
+        unpackVertices(*loaded);
+        REQUIRE(loaded->vertices.size() == 3);
+        CHECK(loaded->vertices[2].position.y == Catch::Approx(-1.F));
+        CHECK(loaded->vertices[1].uv.x == Catch::Approx(1.F));
+    }
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Texture imports are configured by how materials use them", "[Converter]")
+{
+    AssetImportResult2 asset;
+    asset.textures = {"models/albedo.png", "models/normal.png", "models/roughness.png"};
+    asset.materials.push_back(AssetImportResult2::Material {
+        .albedoTextureIndex = 0,
+        .normalTextureIndex = 1,
+        .roughnessTextureIndex = 2,
+    });
+
+    std::vector<TextureImport> const imports = makeTextureImports(asset, "textures");
+    REQUIRE(imports.size() == 3);
+
+    CHECK(imports[0].savePath == std::filesystem::path("textures") / "albedo.extex");
+    CHECK(imports[0].mips.srgb);
+    CHECK(imports[0].compression->perceptual);
+
+    CHECK(imports[1].mips.normalMap);
+    CHECK_FALSE(imports[1].mips.srgb);
+    CHECK_FALSE(imports[1].compression->perceptual);
+
+    CHECK_FALSE(imports[2].mips.srgb);
+    CHECK_FALSE(imports[2].mips.normalMap);
+    CHECK_FALSE(imports[2].compression->perceptual);
+}
@@ -0,0 +1,70 @@
+#include <cstdint>
+#include <memory_resource>
+#include <thread>
+#include <tuple>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Core/FrameArena.h"
+
+using namespace exage;
+
+TEST_CASE("Linear arenas bump allocate and settle on one block", "[FrameArena]")
+{
+    LinearArena arena {256};
+
+    auto* first = static_cast<std::byte*>(arena.allocate(10, 1));
+    auto* second = static_cast<std::byte*>(arena.allocate(16, 16));
+    REQUIRE(reinterpret_cast<uintptr_t>(second) % 16 == 0);
+    REQUIRE(second >= first + 10);
+    REQUIRE(arena.getUsed() <= 32);
+
+    // Overflowing chains on more blocks, and the reset merges them
+    auto* large = static_cast<std::byte*>(arena.allocate(1000, 64));
+    REQUIRE(reinterpret_cast<uintptr_t>(large) % 64 == 0);
+    REQUIRE(arena.getCapacity() > 1000);
+
+    size_t const capacity = arena.getCapacity();
+    arena.reset();
+    REQUIRE(arena.getUsed() == 0);
+    REQUIRE(arena.getCapacity() == capacity);
+
+    // Everything from before now fits without growing
+    std::ignore = arena.allocate(10, 1);
+    std::ignore = arena.allocate(16, 16);
+    std::ignore = arena.allocate(1000, 64);
+    REQUIRE(arena.getCapacity() == capacity);
+
+    std::pmr::vector<int> values {&arena};
+    for (int i = 0; i < 100; i++)
+    {
+        values.push_back(i);
+    }
+    REQUIRE(values[99] == 99);
+
+    std::span<const int> const copied = arena.copy(std::span<const int> {values});
+    REQUIRE(copied.size() == 100);
+    REQUIRE(copied[42] == 42);
+}
+
+TEST_CASE("Frame arenas are per thread and reset with their frame", "[FrameArena]")
+{
+    FrameArena::startFrame(0);
+    LinearArena& mainArena = FrameArena::get();
+    std::ignore = mainArena.allocate(128, 8);
+
+    LinearArena* workerArena = nullptr;
+    std::thread worker {[&] { workerArena = &FrameArena::get(); }};
+    worker.join();
+    REQUIRE(workerArena != &mainArena);
+
+    FrameArena::startFrame(1);
+    REQUIRE(FrameArena::getCurrentFrame() == 1);
+    REQUIRE(&FrameArena::get() != &mainArena);
+    REQUIRE(mainArena.getUsed() == 128);
+
+    FrameArena::startFrame(0);
+    REQUIRE(&FrameArena::get() == &mainArena);
+    REQUIRE(mainArena.getUsed() == 0);
+}
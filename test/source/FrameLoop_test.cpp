@@ -0,0 +1,55 @@
+#include <chrono>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Core/FrameLoop.h"
+
+using namespace exage;
+using namespace std::chrono_literals;
+
+TEST_CASE("Fixed steps accumulate across frames", "[FrameLoop]")
+{
+    FrameLoop loop {10ms, 4};
+
+    REQUIRE(loop.advance(4ms) == 0);
+    REQUIRE(loop.getInterpolation() == Catch::Approx(0.4F));
+
+    REQUIRE(loop.advance(7ms) == 1);
+    REQUIRE(loop.getInterpolation() == Catch::Approx(0.1F));
+
+    REQUIRE(loop.advance(29ms) == 3);
+    REQUIRE(loop.getInterpolation() == Catch::Approx(0.F));
+
+    REQUIRE(loop.getStepCount() == 4);
+    REQUIRE(loop.getDroppedTime() == 0ms);
+    REQUIRE(loop.getFrameSeconds() == Catch::Approx(0.029F));
+}
+
+TEST_CASE("Catch-up is limited and the excess dropped", "[FrameLoop]")
+{
+    FrameLoop loop {10ms, 4};
+
+    // A spike worth ten steps only runs four, keeping the fraction of a step
+    REQUIRE(loop.advance(105ms) == 4);
+    REQUIRE(loop.getDroppedTime() == 60ms);
+    REQUIRE(loop.getInterpolation() == Catch::Approx(0.5F));
+
+    // And does not spill over into the following frames
+    REQUIRE(loop.advance(10ms) == 1);
+    REQUIRE(loop.getStepCount() == 5);
+}
+
+TEST_CASE("The same frame times give the same steps", "[FrameLoop]")
+{
+    FrameLoop first;
+    FrameLoop second;
+
+    for (int i = 0; i < 1000; i++)
+    {
+        auto const frameTime = std::chrono::nanoseconds {3'000'000 + (i * 7919) % 20'000'000};
+        REQUIRE(first.advance(frameTime) == second.advance(frameTime));
+    }
+
+    REQUIRE(first.getStepCount() == second.getStepCount());
+    REQUIRE(first.getInterpolation() == second.getInterpolation());
+}
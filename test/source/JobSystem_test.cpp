@@ -0,0 +1,88 @@
+#include <atomic>
+#include <mutex>
+#include <numeric>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Core/JobSystem.h"
+
+using namespace exage;
+
+TEST_CASE("parallelFor covers every index exactly once", "[JobSystem]")
+{
+    JobSystem jobSystem {3};
+
+    std::vector<std::atomic<int>> visits(10'000);
+    jobSystem.parallelFor(visits.size(),
+                          16,
+                          [&](size_t begin, size_t end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  visits[i]++;
+                              }
+                          });
+
+    for (const auto& visit : visits)
+    {
+        REQUIRE(visit.load() == 1);
+    }
+}
+
+TEST_CASE("Nested fork/join does not deadlock", "[JobSystem]")
+{
+    JobSystem jobSystem {2};
+
+    std::atomic<size_t> total {0};
+    jobSystem.parallelFor(32,
+                          1,
+                          [&](size_t begin, size_t end)
+                          {
+                              for (size_t i = begin; i < end; i++)
+                              {
+                                  jobSystem.parallelFor(
+                                      100, 1, [&](size_t first, size_t last)
+                                      { total += last - first; });
+                              }
+                          });
+
+    REQUIRE(total.load() == 3200);
+}
+
+TEST_CASE("Task graph runs tasks after their dependencies", "[JobSystem]")
+{
+    JobSystem jobSystem {3};
+
+    std::mutex mutex;
+    std::vector<int> order;
+    auto record = [&](int task)
+    {
+        return [&, task]
+        {
+            std::lock_guard const lock {mutex};
+            order.push_back(task);
+        };
+    };
+
+    // A diamond: 0 before 1 and 2, which both come before 3
+    TaskGraph graph;
+    TaskGraph::TaskID first = graph.addTask(record(0));
+    TaskGraph::TaskID left = graph.addTask(record(1));
+    TaskGraph::TaskID right = graph.addTask(record(2));
+    TaskGraph::TaskID last = graph.addTask(record(3));
+    graph.addDependency(first, left);
+    graph.addDependency(first, right);
+    graph.addDependency(left, last);
+    graph.addDependency(right, last);
+
+    for (int frame = 0; frame < 10; frame++)
+    {
+        order.clear();
+        graph.run(jobSystem);
+
+        REQUIRE(order.size() == 4);
+        REQUIRE(order.front() == 0);
+        REQUIRE(order.back() == 3);
+    }
+}
@@ -0,0 +1,120 @@
+#include <chrono>
+#include <filesystem>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Projects/Level.h"
+#include "exage/Projects/LevelStreamer.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Projects;
+    using namespace std::chrono_literals;
+
+    // A row of roots with a few children each, saved to a temporary level file
+    void saveTestLevel(const std::filesystem::path& path, size_t rootCount)
+    {
+        Level level;
+        level.path = path.string();
+
+        for (size_t i = 0; i < rootCount; i++)
+        {
+            Entity const root = level.scene.createEntity();
+            auto& transform = level.scene.addComponent<Transform3D>(root);
+            transform.position = {static_cast<float>(i), 0.F, 0.F};
+
+            for (size_t j = 0; j < 3; j++)
+            {
+                Entity const child = level.scene.createEntity(root);
+                level.scene.addComponent<Transform3D>(child).position = {0.F, 1.F, 0.F};
+            }
+        }
+
+        REQUIRE(saveLevel(path, serializeLevel(level)));
+    }
+
+    auto countSubtree(Scene& scene, Entity entity) -> size_t
+    {
+        size_t count = 1;
+        scene.forEachChild(entity, [&](Entity child) { count += countSubtree(scene, child); });
+        return count;
+    }
+}  // namespace
+
+TEST_CASE("Streamed levels are committed in batches and unloaded", "[Projects]")
+{
+    std::filesystem::path const path =
+        std::filesystem::temp_directory_path() / "LevelStreamer_test.exlevel";
+    size_t const rootCount = 100;
+    saveTestLevel(path, rootCount);
+
+    Scene scene;
+    Entity const existing = scene.createEntity();
+    scene.addComponent<Transform3D>(existing);
+
+    LevelStreamer streamer {scene};
+    LevelStreamer::LevelID const level = streamer.load(path);
+
+    // A zero budget still commits a batch per call
+    size_t partialCommits = 0;
+    while (streamer.getState(level) != StreamingState::eLoaded)
+    {
+        REQUIRE(streamer.getState(level) != StreamingState::eFailed);
+        if (!streamer.commit(0us))
+        {
+            partialCommits++;
+        }
+    }
+    REQUIRE(partialCommits > 1);
+
+    Entity const root = streamer.getRoot(level);
+    REQUIRE(scene.isValid(root));
+    REQUIRE(countSubtree(scene, root) == 1 + rootCount * 4);
+
+    scene.updateHierarchy();
+    size_t moved = 0;
+    scene.forEachChild(root,
+                       [&](Entity child)
+                       {
+                           auto const& transform = scene.getComponent<Transform3D>(child);
+                           REQUIRE(transform.globalPosition.x < static_cast<float>(rootCount));
+                           moved++;
+                       });
+    REQUIRE(moved == rootCount);
+
+    streamer.unload(level);
+    REQUIRE(streamer.getState(level) == StreamingState::eUnloading);
+    while (!streamer.commit(0us))
+    {
+    }
+
+    REQUIRE_FALSE(scene.isValid(root));
+    REQUIRE(scene.isValid(existing));
+    REQUIRE(scene.registry().view<Transform3D>().size() == 1);
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Streaming a missing level fails without touching the scene", "[Projects]")
+{
+    Scene scene;
+    LevelStreamer streamer {scene};
+
+    LevelStreamer::LevelID const level =
+        streamer.load(std::filesystem::temp_directory_path() / "LevelStreamer_missing.exlevel");
+    while (streamer.getState(level) == StreamingState::eLoading)
+    {
+        streamer.commit(1ms);
+    }
+
+    REQUIRE(streamer.getState(level) == StreamingState::eFailed);
+    REQUIRE(streamer.getError(level).has_value());
+    REQUIRE(streamer.getRoot(level) == entt::null);
+    REQUIRE(scene.registry().view<Transform3D>().size() == 0);
+
+    streamer.unload(level);
+}
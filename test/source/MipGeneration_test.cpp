@@ -0,0 +1,157 @@
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/Loader/MipGeneration.h"
+
+using namespace exage;
+using namespace exage::Renderer;
+
+namespace
+{
+    // A single level of 8-bit texels given by value(x, y, channel)
+    template<typename F>
+    auto makeTexture(uint32_t width, uint32_t height, uint8_t channels, F&& value) -> Texture
+    {
+        Texture texture {};
+        texture.channels = channels;
+        texture.bitsPerChannel = 8;
+        texture.layers = 1;
+        texture.type = Graphics::Texture::Type::e2D;
+
+        size_t const size = static_cast<size_t>(width) * height * channels;
+        texture.mips.push_back({glm::uvec3 {width, height, 1}, 0, size});
+        texture.data.resize(size);
+
+        for (uint32_t y = 0; y < height; y++)
+        {
+            for (uint32_t x = 0; x < width; x++)
+            {
+                for (uint8_t c = 0; c < channels; c++)
+                {
+                    texture.data[(static_cast<size_t>(y) * width + x) * channels + c] =
+                        static_cast<std::byte>(value(x, y, c));
+                }
+            }
+        }
+        return texture;
+    }
+
+    auto getTexel(const Texture& texture, size_t mip, uint32_t x, uint32_t y, uint8_t channel)
+        -> uint8_t
+    {
+        const Texture::Mip& level = texture.mips[mip];
+        size_t const index =
+            (static_cast<size_t>(y) * level.extent.x + x) * texture.channels + channel;
+        return static_cast<uint8_t>(texture.data[level.offset + index]);
+    }
+
+    auto checkerboard(uint32_t x, uint32_t y, uint8_t channel) -> uint8_t
+    {
+        return channel == 3 || (x + y) % 2 == 0 ? 255 : 0;
+    }
+}  // namespace
+
+TEST_CASE("Mip chains halve down to 1x1 and are laid out contiguously", "[MipGeneration]")
+{
+    Texture texture = makeTexture(12, 5, 4, checkerboard);
+    std::vector<std::byte> const original = texture.data;
+
+    REQUIRE(generateMips(texture).has_value());
+
+    std::vector<glm::uvec3> const extents {{12, 5, 1}, {6, 2, 1}, {3, 1, 1}, {1, 1, 1}};
+    REQUIRE(texture.mips.size() == extents.size());
+
+    size_t offset = 0;
+    for (size_t i = 0; i < extents.size(); i++)
+    {
+        CHECK(texture.mips[i].extent == extents[i]);
+        CHECK(texture.mips[i].offset == offset);
+        CHECK(texture.mips[i].size == static_cast<size_t>(extents[i].x) * extents[i].y * 4);
+        offset += texture.mips[i].size;
+    }
+    CHECK(texture.data.size() == offset);
+    CHECK(std::memcmp(texture.data.data(), original.data(), original.size()) == 0);
+
+    Texture limited = makeTexture(12, 5, 4, checkerboard);
+    REQUIRE(generateMips(limited, {.maxLevels = 2}).has_value());
+    CHECK(limited.mips.size() == 2);
+
+    // Array slices stay together within each level
+    Texture layered = makeTexture(4, 4, 1, [](uint32_t, uint32_t, uint8_t) { return 0; });
+    layered.layers = 2;
+    layered.data.resize(32, std::byte {200});
+    layered.mips[0].size = 32;
+    REQUIRE(generateMips(layered, {.filter = MipFilter::eBox}).has_value());
+    REQUIRE(layered.mips.size() == 3);
+    CHECK(layered.mips[1].size == 8);
+    CHECK(getTexel(layered, 1, 0, 0, 0) == 0);
+    CHECK(static_cast<uint8_t>(layered.data[layered.mips[1].offset + 4]) == 200);
+
+    Texture compressed = makeTexture(4, 4, 4, checkerboard);
+    compressed.compressedFormat = Graphics::Format::eBC7RGBA8;
+    CHECK_FALSE(generateMips(compressed).has_value());
+}
+
+TEST_CASE("Color is averaged in linear space", "[MipGeneration]")
+{
+    Texture linear = makeTexture(8, 8, 4, checkerboard);
+    REQUIRE(generateMips(linear, {.filter = MipFilter::eBox}).has_value());
+
+    Texture srgb = makeTexture(8, 8, 4, checkerboard);
+    REQUIRE(generateMips(srgb, {.filter = MipFilter::eBox, .srgb = true}).has_value());
+
+    for (size_t mip = 1; mip < linear.mips.size(); mip++)
+    {
+        INFO("Mip " << mip);
+
+        // Half of full intensity, which sRGB encodes as 188
+        CHECK(getTexel(linear, mip, 0, 0, 0) == 128);
+        CHECK(getTexel(srgb, mip, 0, 0, 1) == 188);
+        CHECK(getTexel(srgb, mip, 0, 0, 3) == 255);
+    }
+}
+
+TEST_CASE("Filters keep flat images flat", "[MipGeneration]")
+{
+    for (MipFilter filter : {MipFilter::eBox, MipFilter::eKaiser, MipFilter::eLanczos})
+    {
+        Texture texture = makeTexture(
+            9, 7, 2, [](uint32_t, uint32_t, uint8_t channel) { return channel == 0 ? 37 : 201; });
+        REQUIRE(generateMips(texture, {.filter = filter, .srgb = true}).has_value());
+
+        for (size_t i = texture.mips[0].size; i < texture.data.size(); i += 2)
+        {
+            CHECK(static_cast<uint8_t>(texture.data[i]) == 37);
+            CHECK(static_cast<uint8_t>(texture.data[i + 1]) == 201);
+        }
+    }
+}
+
+TEST_CASE("Normal maps are renormalized at every level", "[MipGeneration]")
+{
+    // Alternating columns facing +x and +z, mapped from [-1, 1]
+    Texture texture = makeTexture(4,
+                                  4,
+                                  3,
+                                  [](uint32_t x, uint32_t, uint8_t channel)
+                                  { return channel == (x % 2 == 0 ? 0 : 2) ? 255 : 128; });
+    REQUIRE(generateMips(texture, {.filter = MipFilter::eBox, .normalMap = true}).has_value());
+
+    for (size_t mip = 1; mip < texture.mips.size(); mip++)
+    {
+        INFO("Mip " << mip);
+
+        float length = 0.F;
+        for (uint8_t c = 0; c < 3; c++)
+        {
+            float const value = getTexel(texture, mip, 0, 0, c) / 255.F * 2.F - 1.F;
+            length += value * value;
+        }
+        CHECK(std::sqrt(length) == Catch::Approx(1.F).margin(0.02F));
+        CHECK(getTexel(texture, mip, 0, 0, 0) == getTexel(texture, mip, 0, 0, 2));
+    }
+}
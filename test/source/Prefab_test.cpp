@@ -0,0 +1,106 @@
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/Prefab.h"
+#include "exage/Renderer/SceneExtractor.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    auto translation(glm::vec3 offset) -> glm::mat4
+    {
+        glm::mat4 matrix {1.F};
+        matrix[3] = glm::vec4 {offset, 1.F};
+        return matrix;
+    }
+
+    // A trunk with two branches, where the branches share a mesh
+    auto makeTree() -> Prefab
+    {
+        Prefab prefab;
+        prefab.path = "tree.exprefab";
+        prefab.handle = internAsset(prefab.path);
+
+        AABB const unit {glm::vec4 {-0.5F, -0.5F, -0.5F, 0.F}, glm::vec4 {0.5F, 0.5F, 0.5F, 0.F}};
+        prefab.meshes.push_back({internAsset("trunk.exmesh"), unit});
+        prefab.meshes.push_back({internAsset("branch.exmesh"), unit});
+
+        prefab.nodes.push_back({translation({0.F, 0.F, 0.F}), Prefab::NO_PARENT, 0});
+        prefab.nodes.push_back({translation({2.F, 1.F, 0.F}), 0, 1});
+        prefab.nodes.push_back({translation({-2.F, 1.F, 0.F}), 0, 1});
+
+        prefab.aabb = calculatePrefabBounds(prefab);
+        return prefab;
+    }
+}  // namespace
+
+TEST_CASE("Prefab placements expand into their meshes", "[Renderer]")
+{
+    Prefab const prefab = makeTree();
+
+    REQUIRE(prefab.aabb.min.x == -2.5F);
+    REQUIRE(prefab.aabb.max.x == 2.5F);
+    REQUIRE(prefab.aabb.max.y == 1.5F);
+
+    glm::mat4 const model = translation({100.F, 0.F, 0.F});
+
+    SECTION("Without overrides")
+    {
+        std::vector<float> positions;
+        forEachPrefabMesh(prefab,
+                          {},
+                          model,
+                          [&](const glm::mat4& matrix, const PrefabMesh& /*mesh*/)
+                          { positions.push_back(matrix[3].x); });
+
+        REQUIRE(positions == std::vector<float> {100.F, 102.F, 98.F});
+    }
+
+    SECTION("With overrides")
+    {
+        std::vector<PrefabOverride> const overrides {{1, PrefabOverride::HIDDEN}, {2, 0}};
+
+        std::vector<AssetHandle> meshes;
+        forEachPrefabMesh(prefab,
+                          overrides,
+                          model,
+                          [&](const glm::mat4& /*matrix*/, const PrefabMesh& mesh)
+                          { meshes.push_back(mesh.mesh); });
+
+        REQUIRE(meshes == std::vector<AssetHandle> {prefab.meshes[0].mesh, prefab.meshes[0].mesh});
+
+        AABB const bounds = calculatePrefabBounds(prefab, overrides);
+        REQUIRE(bounds.min.x == -2.5F);
+        REQUIRE(bounds.max.x == 0.5F);
+    }
+}
+
+TEST_CASE("Prefab placements are extracted as a single instance", "[Renderer]")
+{
+    Scene scene;
+    SceneExtractor extractor {scene};
+
+    Entity placement = scene.createEntity();
+    scene.addComponent<Transform3D>(placement).position = glm::vec3 {5.F, 0.F, 0.F};
+    scene.addComponent<PrefabInstance>(placement,
+                                       PrefabInstance {.prefab = internAsset("tree.exprefab")});
+
+    scene.updateHierarchy(true);
+    extractor.extract();
+
+    const RenderSnapshot* snapshot = extractor.acquire();
+    REQUIRE(snapshot != nullptr);
+    REQUIRE(snapshot->meshes.empty());
+
+    const PrefabPlacement* instance = snapshot->prefabs.find(placement);
+    REQUIRE(instance != nullptr);
+    REQUIRE(getAssetPath(instance->prefab) == "tree.exprefab");
+    REQUIRE(instance->model[3].x == 5.F);
+
+    extractor.release(*snapshot);
+}
@@ -0,0 +1,201 @@
+#include <cmath>
+#include <string>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/SceneExtractor.h"
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+#include "exage/utils/math.h"
+
+namespace
+{
+    using namespace exage;
+    using namespace exage::Renderer;
+
+    auto createMesh(Scene& scene, Entity parent, float offset) -> Entity
+    {
+        Entity entity = scene.createEntity(parent);
+        auto& transform = scene.addComponent<Transform3D>(entity);
+        transform.position = glm::vec3(offset, 0.F, 0.F);
+        scene.addComponent<StaticMeshComponent>(
+            entity, internAsset("mesh" + std::to_string(static_cast<int>(offset))));
+        return entity;
+    }
+
+    // Every snapshot must agree with the scene, whichever ring slot it came from
+    void requireMatchesScene(Scene& scene, const RenderSnapshot& snapshot)
+    {
+        size_t count = 0;
+
+        auto view = scene.registry().view<StaticMeshComponent, Transform3D>();
+        for (Entity entity : view)
+        {
+            const MeshInstance* instance = snapshot.meshes.find(entity);
+            REQUIRE(instance != nullptr);
+            REQUIRE(instance->model == view.get<Transform3D>(entity).globalMatrix);
+            REQUIRE(instance->mesh == view.get<StaticMeshComponent>(entity).mesh);
+            count++;
+        }
+
+        REQUIRE(snapshot.meshes.size() == count);
+    }
+
+    void extractFrame(Scene& scene, SceneExtractor& extractor)
+    {
+        scene.updateHierarchy(true);
+        extractor.extract();
+
+        const RenderSnapshot* snapshot = extractor.acquire();
+        REQUIRE(snapshot != nullptr);
+        requireMatchesScene(scene, *snapshot);
+        extractor.release(*snapshot);
+    }
+}  // namespace
+
+TEST_CASE("Extracted snapshots follow incremental scene changes", "[Renderer]")
+{
+    Scene scene;
+    SceneExtractor extractor {scene};
+    REQUIRE(extractor.acquire() == nullptr);
+
+    std::vector<Entity> roots;
+    for (int i = 0; i < 64; i++)
+    {
+        Entity root = createMesh(scene, entt::null, static_cast<float>(i));
+        createMesh(scene, root, 1.F);
+        roots.push_back(root);
+    }
+    extractFrame(scene, extractor);
+
+    // Few enough changes per frame for the dirty path, over more frames than there are slots
+    for (size_t frame = 0; frame < SceneExtractor::SNAPSHOT_COUNT * 2; frame++)
+    {
+        scene.updateTransform(roots[frame],
+                              [](Transform3D& transform) { transform.position.y += 1.F; });
+
+        if (frame == 1)
+        {
+            scene.removeComponent<StaticMeshComponent>(roots[10]);
+        }
+        if (frame == 2)
+        {
+            scene.destroyEntity(roots[20]);
+            createMesh(scene, roots[30], 2.F);
+        }
+
+        extractFrame(scene, extractor);
+    }
+}
+
+TEST_CASE("A snapshot held by the renderer is not overwritten", "[Renderer]")
+{
+    Scene scene;
+    SceneExtractor extractor {scene};
+
+    Entity entity = createMesh(scene, entt::null, 1.F);
+    scene.updateHierarchy(true);
+    extractor.extract();
+
+    const RenderSnapshot* held = extractor.acquire();
+    REQUIRE(held != nullptr);
+    uint64_t const heldFrame = held->frame;
+    glm::mat4 const heldModel = held->meshes.find(entity)->model;
+
+    // The ring can move on while the oldest snapshot is still being rendered
+    for (size_t frame = 0; frame + 1 < SceneExtractor::SNAPSHOT_COUNT; frame++)
+    {
+        scene.updateTransform(entity, [](Transform3D& transform) { transform.position.x += 1.F; });
+        scene.updateHierarchy(true);
+        extractor.extract();
+    }
+
+    REQUIRE(held->frame == heldFrame);
+    REQUIRE(held->meshes.find(entity)->model == heldModel);
+
+    const RenderSnapshot* latest = extractor.acquire();
+    REQUIRE(latest != held);
+    REQUIRE(latest->frame == heldFrame + SceneExtractor::SNAPSHOT_COUNT - 1);
+    requireMatchesScene(scene, *latest);
+
+    extractor.release(*latest);
+    extractor.release(*held);
+}
+
+TEST_CASE("Instances keep their model from the previous extraction", "[Renderer]")
+{
+    Scene scene;
+    SceneExtractor extractor {scene};
+
+    Entity moving = createMesh(scene, entt::null, 1.F);
+    Entity still = createMesh(scene, entt::null, 2.F);
+
+    // Moves on even frames only, so every ring slot sees both a move and a settled frame
+    glm::mat4 lastModel {0.F};
+    for (size_t frame = 0; frame < SceneExtractor::SNAPSHOT_COUNT * 2 + 1; frame++)
+    {
+        bool const moved = frame % 2 == 0 && frame > 0;
+        if (moved)
+        {
+            scene.updateTransform(moving,
+                                  [](Transform3D& transform) { transform.position.x += 1.F; });
+        }
+        scene.updateHierarchy(true);
+        extractor.extract();
+
+        const RenderSnapshot* snapshot = extractor.acquire();
+        REQUIRE(snapshot != nullptr);
+
+        const MeshInstance* instance = snapshot->meshes.find(moving);
+        REQUIRE(instance->model == scene.getComponent<Transform3D>(moving).globalMatrix);
+        REQUIRE(instance->previousModel == (frame == 0 ? instance->model : lastModel));
+        REQUIRE((instance->previousModel != instance->model) == moved);
+        lastModel = instance->model;
+
+        const MeshInstance* stillInstance = snapshot->meshes.find(still);
+        REQUIRE(stillInstance->previousModel == stillInstance->model);
+
+        extractor.release(*snapshot);
+    }
+}
+
+TEST_CASE("Degenerate transforms interpolate to finite matrices", "[Renderer]")
+{
+    auto requireFinite = [](const glm::mat4& matrix)
+    {
+        for (int column = 0; column < 4; column++)
+        {
+            for (int row = 0; row < 4; row++)
+            {
+                REQUIRE(std::isfinite(matrix[column][row]));
+            }
+        }
+    };
+
+    glm::mat4 const shown = glm::translate(glm::vec3 {1.F, 2.F, 3.F})
+        * glm::mat4_cast(glm::angleAxis(1.F, glm::vec3 {0.F, 1.F, 0.F}));
+
+    // Scaled up from nothing to pop in
+    glm::mat4 const hidden = shown * glm::scale(glm::vec3 {0.F});
+    glm::mat4 const popIn = interpolateTransform(hidden, shown, 0.25F);
+    requireFinite(popIn);
+    for (int column = 0; column < 4; column++)
+    {
+        for (int row = 0; row < 4; row++)
+        {
+            CHECK(popIn[column][row]
+                  == Catch::Approx(hidden[column][row] * 0.75F + shown[column][row] * 0.25F));
+        }
+    }
+    CHECK(interpolateTransform(shown, hidden, 1.F) == hidden);
+
+    // Mirrored along x, which a rotation cannot represent
+    glm::mat4 const mirrored = glm::scale(glm::vec3 {-1.F, 1.F, 1.F});
+    glm::mat4 const moved = glm::translate(glm::vec3 {4.F, 0.F, 0.F}) * mirrored;
+    glm::mat4 const halfway = interpolateTransform(mirrored, moved, 0.5F);
+    requireFinite(halfway);
+    CHECK(halfway[0][0] == Catch::Approx(-1.F));
+    CHECK(halfway[3][0] == Catch::Approx(2.F));
+    CHECK(glm::determinant(glm::mat3 {halfway}) < 0.F);
+}
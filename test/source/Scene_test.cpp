@@ -0,0 +1,602 @@
+#include <algorithm>
+#include <cstring>
+#include <memory_resource>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Scene/Hierarchy.h"
+#include "exage/Scene/Scene.h"
+
+namespace
+{
+    using namespace exage;
+
+    auto createTransformed(Scene& scene, Entity parent, float offset) -> Entity
+    {
+        Entity entity = scene.createEntity(parent);
+        auto& transform = scene.addComponent<Transform3D>(entity);
+        transform.position = glm::vec3(offset, 2.F * offset, -offset);
+        transform.scale = glm::vec3(1.F + 0.1F * offset);
+        transform.rotation = Rotation3D {glm::vec3(0.3F * offset, 0.2F, -0.1F * offset)};
+        return entity;
+    }
+
+    void buildTestScene(Scene& scene)
+    {
+        for (int r = 0; r < 4; r++)
+        {
+            Entity root = createTransformed(scene, entt::null, static_cast<float>(r));
+
+            // Children of an entity without a Transform3D are parented to the closest ancestor
+            Entity passthrough = scene.createEntity(root);
+
+            for (int c = 0; c < 8; c++)
+            {
+                Entity child = createTransformed(
+                    scene, c % 2 == 0 ? root : passthrough, static_cast<float>(c) * 0.5F);
+                createTransformed(scene, child, 1.5F);
+            }
+        }
+    }
+
+    // Forwards to the default resource, keeping track of what is still allocated
+    class CountingResource : public std::pmr::memory_resource
+    {
+      public:
+        size_t allocated = 0;
+        size_t outstanding = 0;
+
+      private:
+        auto do_allocate(size_t bytes, size_t alignment) -> void* override
+        {
+            allocated += bytes;
+            outstanding += bytes;
+            return std::pmr::get_default_resource()->allocate(bytes, alignment);
+        }
+
+        void do_deallocate(void* pointer, size_t bytes, size_t alignment) override
+        {
+            outstanding -= bytes;
+            std::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+        }
+
+        [[nodiscard]] auto do_is_equal(const std::pmr::memory_resource& other) const noexcept
+            -> bool override
+        {
+            return this == &other;
+        }
+    };
+
+    template<typename T>
+    auto bitEqual(const T& lhs, const T& rhs) -> bool
+    {
+        return std::memcmp(&lhs, &rhs, sizeof(T)) == 0;
+    }
+}  // namespace
+
+TEST_CASE("Flattened transform propagation matches the recursive path", "[Scene]")
+{
+    Scene recursive;
+    Scene flattened;
+    buildTestScene(recursive);
+    buildTestScene(flattened);
+
+    recursive.setTransformPropagation(TransformPropagation::eRecursive);
+    flattened.setTransformPropagation(TransformPropagation::eFlattened);
+
+    recursive.updateHierarchy(true);
+    flattened.updateHierarchy(true);
+
+    auto view = recursive.registry().view<Transform3D>();
+    REQUIRE(view.size() == flattened.registry().view<Transform3D>().size());
+
+    for (Entity entity : view)
+    {
+        const auto& expected = view.get<Transform3D>(entity);
+        const auto& actual = flattened.getComponent<Transform3D>(entity);
+
+        REQUIRE(bitEqual(expected.matrix, actual.matrix));
+        REQUIRE(bitEqual(expected.globalMatrix, actual.globalMatrix));
+        REQUIRE(bitEqual(expected.globalPosition, actual.globalPosition));
+        REQUIRE(bitEqual(expected.globalScale, actual.globalScale));
+
+        glm::quat expectedRotation = expected.globalRotation.getQuaternion();
+        glm::quat actualRotation = actual.globalRotation.getQuaternion();
+        REQUIRE(bitEqual(expectedRotation, actualRotation));
+    }
+}
+
+TEST_CASE("Dirty transform updates match a full recompute", "[Scene]")
+{
+    Scene incremental;
+    Scene full;
+    buildTestScene(incremental);
+    buildTestScene(full);
+
+    incremental.updateHierarchy(true);
+
+    // Move a single child; only its subtree should be recomputed
+    Entity root = entt::null;
+    incremental.forEachRoot([&](Entity entity) { root = entity; });
+    Entity moved = incremental.getComponent<EntityRelationship>(root).firstChild;
+    while (!incremental.hasComponent<Transform3D>(moved))
+    {
+        moved = incremental.getComponent<EntityRelationship>(moved).nextSibling;
+    }
+
+    auto move = [](Transform3D& transform) { transform.position += glm::vec3(3.F, -1.F, 0.5F); };
+    incremental.updateTransform(moved, move);
+    full.updateTransform(moved, move);
+
+    incremental.updateHierarchy(true);
+    full.markAllTransformsDirty();
+    full.updateHierarchy(true);
+
+    auto view = full.registry().view<Transform3D>();
+    for (Entity entity : view)
+    {
+        const auto& expected = view.get<Transform3D>(entity);
+        const auto& actual = incremental.getComponent<Transform3D>(entity);
+
+        REQUIRE(bitEqual(expected.globalMatrix, actual.globalMatrix));
+        REQUIRE(bitEqual(expected.globalPosition, actual.globalPosition));
+    }
+}
+
+TEST_CASE("Replacing or removing a transform updates its subtree", "[Scene]")
+{
+    Scene incremental;
+    Scene full;
+    buildTestScene(incremental);
+    buildTestScene(full);
+
+    incremental.updateHierarchy(true);
+
+    // Two transformed children of the same root, each with a transformed child of its own
+    Entity root = entt::null;
+    incremental.forEachRoot([&](Entity entity) { root = entity; });
+    std::vector<Entity> children;
+    incremental.forEachChild(root,
+                             [&](Entity child)
+                             {
+                                 if (incremental.hasComponent<Transform3D>(child))
+                                 {
+                                     children.push_back(child);
+                                 }
+                             });
+    REQUIRE(children.size() >= 2);
+
+    // Through the registry, like the editor's add-component menu, rather than updateTransform
+    for (Scene* scene : {&incremental, &full})
+    {
+        scene->registry().replace<Transform3D>(children[0]);
+        scene->registry().remove<Transform3D>(children[1]);
+    }
+
+    incremental.updateHierarchy(true);
+    full.markAllTransformsDirty();
+    full.updateHierarchy(true);
+
+    auto view = full.registry().view<Transform3D>();
+    REQUIRE(view.size() == incremental.registry().view<Transform3D>().size());
+    for (Entity entity : view)
+    {
+        const auto& expected = view.get<Transform3D>(entity);
+        const auto& actual = incremental.getComponent<Transform3D>(entity);
+
+        REQUIRE(bitEqual(expected.globalMatrix, actual.globalMatrix));
+        REQUIRE(bitEqual(expected.globalPosition, actual.globalPosition));
+    }
+}
+
+TEST_CASE("RootEntity follows reparenting", "[Scene]")
+{
+    Scene scene;
+    Entity root = scene.createEntity();
+    Entity child = scene.createEntity(root);
+
+    REQUIRE(scene.hasComponent<RootEntity>(root));
+    REQUIRE_FALSE(scene.hasComponent<RootEntity>(child));
+
+    scene.setParent(child, entt::null);
+    REQUIRE(scene.hasComponent<RootEntity>(child));
+
+    scene.setParent(root, child);
+    REQUIRE_FALSE(scene.hasComponent<RootEntity>(root));
+}
+
+TEST_CASE("Bulk creation links entities like createEntity", "[Scene]")
+{
+    Scene scene;
+    Entity parent = scene.createEntity();
+    scene.createEntity(parent);
+
+    std::vector<Entity> children = scene.createEntities(3, parent);
+    REQUIRE(scene.getComponent<EntityRelationship>(parent).childCount == 4);
+
+    size_t visited = 0;
+    scene.forEachChild(parent,
+                       [&](Entity child)
+                       {
+                           REQUIRE(scene.getComponent<EntityRelationship>(child).parent == parent);
+                           visited++;
+                       });
+    REQUIRE(visited == 4);
+
+    ScenePrefab prefab;
+    prefab.parents = {ScenePrefab::NO_PARENT, 0, 0, 1};
+    prefab.transforms.resize(4);
+
+    std::vector<Entity> roots = scene.instantiate(prefab);
+    REQUIRE(scene.hasComponent<RootEntity>(roots[0]));
+    REQUIRE_FALSE(scene.hasComponent<RootEntity>(roots[1]));
+    REQUIRE(scene.getComponent<EntityRelationship>(roots[0]).childCount == 2);
+    REQUIRE(scene.getComponent<EntityRelationship>(roots[3]).parent == roots[1]);
+
+    // Top-level nodes may each name an existing parent, and transforms may be left out
+    ScenePrefab attached;
+    attached.parents = {ScenePrefab::NO_PARENT, ScenePrefab::NO_PARENT, 1, ScenePrefab::NO_PARENT};
+    attached.externalParents = {parent, roots[2], entt::null, parent};
+
+    std::vector<Entity> linked = scene.instantiate(attached);
+    REQUIRE(scene.getComponent<EntityRelationship>(parent).childCount == 6);
+    REQUIRE(scene.getComponent<EntityRelationship>(parent).firstChild == linked[3]);
+    REQUIRE(scene.getComponent<EntityRelationship>(linked[3]).nextSibling == linked[0]);
+    REQUIRE(scene.getComponent<EntityRelationship>(linked[0]).previousSibling == linked[3]);
+    REQUIRE(scene.getComponent<EntityRelationship>(linked[0]).nextSibling == children[2]);
+    REQUIRE(scene.getComponent<EntityRelationship>(children[2]).previousSibling == linked[0]);
+    REQUIRE(scene.getComponent<EntityRelationship>(linked[1]).parent == roots[2]);
+    REQUIRE(scene.getComponent<EntityRelationship>(linked[2]).parent == linked[1]);
+    REQUIRE(scene.getComponent<EntityRelationship>(roots[2]).childCount == 1);
+    REQUIRE_FALSE(scene.hasComponent<RootEntity>(linked[1]));
+    REQUIRE_FALSE(scene.hasComponent<Transform3D>(linked[0]));
+
+    // Nested subtree roots are only destroyed once
+    std::vector<Entity> destroyed = {roots[1], roots[0], children[2]};
+    scene.destroySubtrees(destroyed);
+
+    REQUIRE(scene.getComponent<EntityRelationship>(parent).childCount == 5);
+    for (Entity entity : roots)
+    {
+        REQUIRE_FALSE(scene.registry().valid(entity));
+    }
+    REQUIRE_FALSE(scene.registry().valid(linked[2]));
+}
+
+TEST_CASE("Queued subtrees are destroyed together at the sync point", "[Scene]")
+{
+    Scene scene;
+
+    // Enough roots for the subtrees to be gathered on several threads, four entities each
+    std::vector<Entity> const roots = scene.createEntities(2048);
+    std::vector<Entity> grandParents;
+    for (Entity root : roots)
+    {
+        std::vector<Entity> const children = scene.createEntities(2, root);
+        scene.createEntity(children[0]);
+        grandParents.push_back(children[0]);
+    }
+    size_t const entityCount = scene.registry().storage<EntityRelationship>().size();
+
+    // Queued while the roots are being iterated, which destroying right away would break
+    size_t visited = 0;
+    scene.forEachRoot(
+        [&](Entity root)
+        {
+            if (visited++ % 2 == 0)
+            {
+                scene.queueDestroy(root);
+            }
+        });
+
+    size_t queuedRoots = 0;
+    Entity kept = entt::null;
+    for (size_t i = 0; i < roots.size(); i++)
+    {
+        REQUIRE(scene.isValid(roots[i]));
+        if (scene.isPendingDestroy(roots[i]))
+        {
+            // Nested in a queued subtree, so it must not be destroyed twice
+            scene.queueDestroy(grandParents[i]);
+            queuedRoots++;
+        }
+        else if (kept == entt::null)
+        {
+            kept = roots[i];
+            scene.queueDestroy(grandParents[i]);
+        }
+    }
+    REQUIRE(queuedRoots == roots.size() / 2);
+
+    REQUIRE(scene.destroyPending() == queuedRoots * 4 + 2);
+    REQUIRE(scene.destroyPending() == 0);
+
+    REQUIRE(scene.registry().storage<EntityRelationship>().size()
+            == entityCount - queuedRoots * 4 - 2);
+    REQUIRE(scene.registry().view<RootEntity>().size() == roots.size() - queuedRoots);
+    for (size_t i = 0; i < roots.size(); i++)
+    {
+        // Every queued root took its grandparent with it
+        bool const survived = scene.isValid(roots[i]);
+        REQUIRE(scene.isValid(grandParents[i]) == (survived && roots[i] != kept));
+    }
+
+    // The surviving sibling is relinked on its own
+    const auto& relationship = scene.getComponent<EntityRelationship>(kept);
+    REQUIRE(relationship.childCount == 1);
+    const auto& sibling = scene.getComponent<EntityRelationship>(relationship.firstChild);
+    REQUIRE(sibling.previousSibling == entt::null);
+    REQUIRE(sibling.nextSibling == entt::null);
+}
+
+TEST_CASE("Depth-first hierarchy storage matches the linked list", "[Scene]")
+{
+    Scene linked;
+    Scene sorted;
+    buildTestScene(linked);
+    buildTestScene(sorted);
+    sorted.setHierarchyStorage(HierarchyStorage::eDepthFirst);
+
+    // Reparenting after the first sort must be picked up by the next traversal
+    Entity root = entt::null;
+    linked.forEachRoot([&](Entity entity) { root = entity; });
+    Entity detached = linked.getComponent<EntityRelationship>(root).firstChild;
+
+    sorted.forEachRoot([](Entity) {});
+    linked.setParent(detached, entt::null);
+    sorted.setParent(detached, entt::null);
+
+    auto collect = [](Scene& scene)
+    {
+        std::vector<Entity> order;
+        std::vector<Entity> pending;
+        scene.forEachRoot([&](Entity root) { pending.push_back(root); });
+        std::sort(pending.begin(), pending.end());
+
+        while (!pending.empty())
+        {
+            Entity entity = pending.back();
+            pending.pop_back();
+            order.push_back(entity);
+            scene.forEachChild(entity, [&](Entity child) { pending.push_back(child); });
+        }
+        return order;
+    };
+    REQUIRE(collect(linked) == collect(sorted));
+
+    linked.updateHierarchy(true);
+    sorted.updateHierarchy(true);
+
+    auto view = linked.registry().view<Transform3D>();
+    for (Entity entity : view)
+    {
+        const auto& expected = view.get<Transform3D>(entity);
+        const auto& actual = sorted.getComponent<Transform3D>(entity);
+
+        REQUIRE(bitEqual(expected.globalMatrix, actual.globalMatrix));
+        REQUIRE(bitEqual(expected.globalPosition, actual.globalPosition));
+    }
+}
+
+TEST_CASE("Batched transform matrices match the glm composition", "[Scene]")
+{
+    // Not a multiple of any SIMD width, so the scalar tail is covered as well
+    constexpr size_t COUNT = 37;
+
+    std::vector<glm::vec3> positions(COUNT);
+    std::vector<glm::quat> rotations(COUNT);
+    std::vector<glm::vec3> scales(COUNT);
+    std::vector<glm::mat4> matrices(COUNT);
+
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        auto const offset = static_cast<float>(i);
+        positions[i] = glm::vec3(offset, -2.F * offset, 0.5F * offset);
+        rotations[i] = glm::quat(glm::vec3(0.1F * offset, -0.3F * offset, 0.7F));
+        scales[i] = glm::vec3(1.F + 0.1F * offset, i % 3 == 0 ? -1.F : 2.F, 0.5F);
+    }
+
+    composeTransformMatrices(positions, rotations, scales, matrices);
+
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        glm::mat4 expected = glm::translate(positions[i]) * glm::toMat4(rotations[i])
+            * glm::scale(scales[i]);
+
+        for (glm::length_t column = 0; column < 4; column++)
+        {
+            for (glm::length_t row = 0; row < 4; row++)
+            {
+                REQUIRE(matrices[i][column][row]
+                        == Catch::Approx(expected[column][row]).margin(1e-5));
+            }
+        }
+    }
+}
+
+TEST_CASE("Batched rotation conversions match Rotation3D", "[Scene]")
+{
+    constexpr size_t COUNT = 37;
+
+    // Large angles exercise every quadrant of the range reduction
+    std::vector<glm::vec3> eulers(COUNT);
+    for (size_t i = 0; i < COUNT; i++)
+    {
+        auto const offset = static_cast<float>(i);
+        eulers[i] = glm::vec3(0.37F * offset - 5.F, -0.91F * offset, 12.F - 0.6F * offset);
+    }
+
+    SECTION("Quaternions to matrices")
+    {
+        std::vector<glm::quat> quaternions(COUNT);
+        std::vector<glm::mat3> matrices(COUNT);
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            quaternions[i] = Rotation3D {eulers[i]}.getQuaternion();
+        }
+
+        quaternionsToMatrices(quaternions, matrices);
+
+        for (size_t i = 0; i < COUNT; i++)
+        {
+            REQUIRE(bitEqual(matrices[i], glm::toMat3(quaternions[i])));
+        }
+    }
+
+    SECTION("Euler angles to quaternions")
+    {
+        for (RotationType type : {RotationType::ePitchYawRoll, RotationType::eYawPitchRoll})
+        {
+            std::vector<glm::quat> quaternions(COUNT);
+            eulerToQuaternions(eulers, quaternions, type);
+
+            for (size_t i = 0; i < COUNT; i++)
+            {
+                glm::quat expected = Rotation3D {eulers[i], type}.getQuaternion();
+
+                for (glm::length_t component = 0; component < 4; component++)
+                {
+                    REQUIRE(quaternions[i][component]
+                            == Catch::Approx(expected[component]).margin(1e-6));
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("Compact transforms match Transform3D world matrices", "[Scene]")
+{
+    Scene full;
+    Scene compact;
+
+    Entity parent = entt::null;
+    for (int depth = 0; depth < 4; depth++)
+    {
+        auto const offset = static_cast<float>(depth);
+        glm::vec3 position {offset, 1.F, -offset};
+        glm::quat rotation {glm::vec3(0.2F * offset, 0.4F, -0.1F)};
+        glm::vec3 scale {1.5F};
+
+        Entity entity = full.createEntity(parent);
+        auto& transform = full.addComponent<Transform3D>(entity);
+        transform.position = position;
+        transform.rotation = rotation;
+        transform.scale = scale;
+
+        // The root stays a Transform3D so the mixed case is covered too
+        REQUIRE(compact.createEntity(parent) == entity);
+        if (depth == 0)
+        {
+            compact.addComponent<Transform3D>(entity, transform);
+        }
+        else
+        {
+            compact.addComponent<CompactTransform>(entity, position, rotation, scale);
+        }
+
+        parent = entity;
+    }
+
+    full.updateHierarchy(true);
+    compact.updateHierarchy(true);
+
+    auto view = compact.registry().view<WorldTransform>();
+    REQUIRE(view.size() == 3);
+
+    for (Entity entity : view)
+    {
+        glm::mat4 expected = full.getComponent<Transform3D>(entity).globalMatrix;
+        glm::mat4 actual = view.get<WorldTransform>(entity).getMatrix();
+
+        for (glm::length_t column = 0; column < 4; column++)
+        {
+            for (glm::length_t row = 0; row < 4; row++)
+            {
+                REQUIRE(actual[column][row] == Catch::Approx(expected[column][row]).margin(1e-4));
+            }
+        }
+    }
+}
+
+TEST_CASE("Scene storages come from its memory resource", "[Scene]")
+{
+    CountingResource resource;
+
+    {
+        Scene scene {&resource};
+        REQUIRE(scene.getMemoryResource() == &resource);
+
+        buildTestScene(scene);
+        scene.updateHierarchy(true);
+
+        size_t const allocated = resource.allocated;
+        REQUIRE(allocated > 0);
+
+        // Moving keeps the storages where they are
+        Scene moved {std::move(scene)};
+        REQUIRE(moved.getMemoryResource() == &resource);
+        REQUIRE(moved.registry().view<Transform3D>().size() == 4 * 17);
+        REQUIRE(resource.allocated == allocated);
+    }
+
+    REQUIRE(resource.outstanding == 0);
+}
+
+TEST_CASE("Change listeners see coalesced component changes", "[Scene]")
+{
+    struct Health
+    {
+        int value = 100;
+    };
+
+    Scene scene;
+    Scene::ChangeListener const listener = scene.addChangeListener<Health>();
+
+    Entity kept = scene.createEntity();
+    Entity patched = scene.createEntity();
+    Entity transient = scene.createEntity();
+    scene.addComponent<Health>(kept);
+    scene.addComponent<Health>(patched);
+    scene.addComponent<Health>(transient);
+
+    // Added and then updated is still added; added and then removed was never there
+    scene.patchComponent<Health>(patched, [](Health& health) { health.value = 50; });
+    scene.removeComponent<Health>(transient);
+
+    auto sorted = [](std::vector<Entity> entities)
+    {
+        std::sort(entities.begin(), entities.end());
+        return entities;
+    };
+
+    ComponentChanges changes;
+    scene.takeChanges<Health>(listener, changes);
+    REQUIRE(sorted(changes.added) == sorted({kept, patched}));
+    REQUIRE(changes.updated.empty());
+    REQUIRE(changes.removed.empty());
+
+    scene.patchComponent<Health>(kept, [](Health& health) { health.value = 0; });
+    scene.destroyEntity(patched);
+
+    // Removed and added again is an update, and a second listener only sees what came after it
+    Scene::ChangeListener const late = scene.addChangeListener<Health>();
+    scene.removeComponent<Health>(kept);
+    scene.addComponent<Health>(kept);
+
+    scene.takeChanges<Health>(listener, changes);
+    REQUIRE(changes.added.empty());
+    REQUIRE(changes.updated == std::vector<Entity> {kept});
+    REQUIRE(changes.removed == std::vector<Entity> {patched});
+
+    scene.takeChanges<Health>(late, changes);
+    REQUIRE(changes.added.empty());
+    REQUIRE(changes.updated == std::vector<Entity> {kept});
+    REQUIRE(changes.removed.empty());
+
+    scene.takeChanges<Health>(listener, changes);
+    REQUIRE(changes.empty());
+
+    scene.removeChangeListener<Health>(late);
+    scene.removeChangeListener<Health>(listener);
+}
@@ -0,0 +1,116 @@
+#include <algorithm>
+#include <cstddef>
+#include <random>
+#include <set>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/Loader/TextureCompression.h"
+
+using namespace exage;
+using namespace exage::Renderer;
+
+namespace
+{
+    // A mip chain down to 1x1 of noise, which no block encodes exactly
+    auto makeNoise(uint32_t width, uint32_t height, uint8_t channels) -> Texture
+    {
+        Texture texture {};
+        texture.channels = channels;
+        texture.bitsPerChannel = 8;
+        texture.layers = 1;
+        texture.type = Graphics::Texture::Type::e2D;
+
+        size_t offset = 0;
+        while (true)
+        {
+            size_t const size = static_cast<size_t>(width) * height * channels;
+            texture.mips.push_back({glm::uvec3 {width, height, 1}, offset, size});
+            offset += size;
+
+            if (width == 1 && height == 1)
+            {
+                break;
+            }
+            width = std::max(width / 2, 1U);
+            height = std::max(height / 2, 1U);
+        }
+
+        std::mt19937 random {7};
+        texture.data.resize(offset);
+        for (std::byte& value : texture.data)
+        {
+            value = static_cast<std::byte>(random() & 0xFF);
+        }
+        return texture;
+    }
+
+    auto countDistinctBlocks(const Texture& texture, size_t mip) -> size_t
+    {
+        std::set<std::vector<std::byte>> blocks;
+        size_t const blockSize = getBlockSize(*texture.compressedFormat);
+        for (size_t offset = 0; offset < texture.mips[mip].size; offset += blockSize)
+        {
+            auto const begin = texture.data.begin()
+                + static_cast<std::ptrdiff_t>(texture.mips[mip].offset + offset);
+            blocks.emplace(begin, begin + static_cast<std::ptrdiff_t>(blockSize));
+        }
+        return blocks.size();
+    }
+}  // namespace
+
+TEST_CASE("Block compression lays out every mip as 4x4 blocks", "[TextureCompression]")
+{
+    Texture texture = makeNoise(10, 6, 4);
+    REQUIRE(compressTexture(texture).has_value());
+
+    REQUIRE(texture.compressedFormat == Graphics::Format::eBC7RGBA8);
+    REQUIRE(texture.mips.size() == 4);
+
+    // 10x6 and 5x3 round up to whole blocks, 2x1 and 1x1 to a single one
+    std::vector<size_t> const blockCounts = {3 * 2, 2 * 1, 1, 1};
+    size_t offset = 0;
+    for (size_t i = 0; i < texture.mips.size(); i++)
+    {
+        REQUIRE(texture.mips[i].offset == offset);
+        REQUIRE(texture.mips[i].size == blockCounts[i] * 16);
+        offset += texture.mips[i].size;
+    }
+    REQUIRE(texture.data.size() == offset);
+    REQUIRE(texture.mips[0].extent == glm::uvec3 {10, 6, 1});
+
+    Texture single = makeNoise(8, 8, 1);
+    REQUIRE(compressTexture(single).has_value());
+    REQUIRE(single.compressedFormat == Graphics::Format::eBC4R8);
+    REQUIRE(single.mips[0].size == 4 * 8);
+}
+
+TEST_CASE("Block compression rejects what it cannot encode", "[TextureCompression]")
+{
+    Texture wide = makeNoise(8, 8, 4);
+    wide.bitsPerChannel = 16;
+    REQUIRE_FALSE(compressTexture(wide).has_value());
+
+    Texture twoChannels = makeNoise(8, 8, 2);
+    REQUIRE_FALSE(
+        compressTexture(twoChannels, {.format = Graphics::Format::eBC1RGBA8}).has_value());
+
+    Texture compressed = makeNoise(8, 8, 2);
+    REQUIRE(compressTexture(compressed).has_value());
+    REQUIRE_FALSE(compressTexture(compressed).has_value());
+}
+
+TEST_CASE("Rate-distortion optimization repeats earlier blocks", "[TextureCompression]")
+{
+    Texture plain = makeNoise(64, 16, 1);
+    Texture optimized = plain;
+
+    REQUIRE(compressTexture(plain).has_value());
+    REQUIRE(compressTexture(optimized, {.rdoTolerance = 1e9F, .rdoWindow = 64}).has_value());
+
+    // With any error allowed, every row of blocks collapses onto its first block
+    REQUIRE(countDistinctBlocks(plain, 0) > 4);
+    REQUIRE(countDistinctBlocks(optimized, 0) == 4);
+    REQUIRE(optimized.data.size() == plain.data.size());
+}
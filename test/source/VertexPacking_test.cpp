@@ -0,0 +1,153 @@
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstring>
+#include <vector>
+
+#include <catch2/catch_all.hpp>
+
+#include "exage/Renderer/Scene/VertexPacking.h"
+
+using namespace exage;
+using namespace exage::Renderer;
+
+namespace
+{
+    auto angleBetween(glm::vec3 a, glm::vec3 b) -> float
+    {
+        return std::acos(std::clamp(glm::dot(glm::normalize(a), glm::normalize(b)), -1.F, 1.F));
+    }
+
+    // A spiral over the sphere, so every octant and the folded seams get hit
+    auto makeDirections(size_t count) -> std::vector<glm::vec3>
+    {
+        std::vector<glm::vec3> directions {{1.F, 0.F, 0.F},
+                                           {0.F, -1.F, 0.F},
+                                           {0.F, 0.F, 1.F},
+                                           {0.F, 0.F, -1.F},
+                                           {-1.F, 0.F, -1.F}};
+        for (size_t i = 0; i < count; i++)
+        {
+            float const z = 1.F - 2.F * (static_cast<float>(i) + 0.5F) / static_cast<float>(count);
+            float const radius = std::sqrt(1.F - z * z);
+            float const angle = 2.39996323F * static_cast<float>(i);
+            directions.emplace_back(radius * std::cos(angle), radius * std::sin(angle), z);
+        }
+        return directions;
+    }
+
+    auto makeMesh() -> StaticMesh
+    {
+        StaticMesh mesh {};
+        mesh.aabb.min = glm::vec4(-2.F, 0.F, 10.F, 1.F);
+        mesh.aabb.max = glm::vec4(3.F, 0.5F, 110.F, 1.F);
+
+        std::vector<glm::vec3> const directions = makeDirections(64);
+        for (size_t i = 0; i + 1 < directions.size(); i++)
+        {
+            float const t = static_cast<float>(i) / static_cast<float>(directions.size());
+
+            glm::vec3 const normal = directions[i];
+            glm::vec3 const tangent =
+                glm::normalize(glm::cross(normal, directions[i + 1] + glm::vec3 {0.F, 0.3F, 0.F}));
+            float const sign = i % 3 == 0 ? -1.F : 1.F;
+
+            StaticMeshVertex vertex {};
+            vertex.position = glm::vec4(-2.F + 5.F * t, 0.5F * t * t, 10.F + 100.F * t, 1.F);
+            vertex.normal = glm::vec4(normal, 0.F);
+            vertex.tangent = glm::vec4(tangent, 0.F);
+            vertex.bitangent = glm::vec4(glm::cross(normal, tangent) * sign, 0.F);
+            vertex.uv = glm::vec4(t * 4.F - 1.F, 1.F - t, 0.F, 0.F);
+            mesh.vertices.push_back(vertex);
+        }
+        return mesh;
+    }
+}  // namespace
+
+TEST_CASE("Octahedral encoding keeps directions to within a small angle", "[VertexPacking]")
+{
+    for (glm::vec3 const direction : makeDirections(2000))
+    {
+        glm::vec3 const decoded = decodeOctahedral(encodeOctahedral(direction));
+        CHECK(glm::dot(decoded, decoded) == Catch::Approx(1.F).margin(1e-5F));
+        CHECK(angleBetween(direction, decoded) < 0.0005F);
+    }
+
+    CHECK(decodeOctahedral({-32768, 0}).x == Catch::Approx(-1.F));
+}
+
+TEST_CASE("Vertex descriptions match the packed structs", "[VertexPacking]")
+{
+    CHECK(getVertexDescription(VertexFormat::eFull).stride == 80);
+    CHECK(getVertexDescription(VertexFormat::ePacked).stride == 24);
+    CHECK(getVertexDescription(VertexFormat::eQuantized).stride == 20);
+
+    CHECK(getVertexDescription(VertexFormat::eFull).attributes.size() == 5);
+    for (VertexFormat format : {VertexFormat::ePacked, VertexFormat::eQuantized})
+    {
+        Graphics::VertexDescription const description = getVertexDescription(format);
+        REQUIRE(description.attributes.size() == 4);
+        CHECK(description.attributes[1].type == Graphics::VertexAttribute::Type::eSnorm16);
+        CHECK(description.attributes[2].type == Graphics::VertexAttribute::Type::eF16);
+    }
+
+    // Quantized positions are read as 4 unorm16, so w must decode as 1 for the translation
+    CHECK(getVertexDescription(VertexFormat::eQuantized).attributes[0].components == 4);
+
+    StaticMesh mesh = makeMesh();
+    packVertices(mesh, VertexFormat::eQuantized);
+
+    std::vector<QuantizedStaticMeshVertex> vertices(mesh.packedVertices.size()
+                                                    / sizeof(QuantizedStaticMeshVertex));
+    std::memcpy(vertices.data(), mesh.packedVertices.data(), mesh.packedVertices.size());
+    for (const QuantizedStaticMeshVertex& vertex : vertices)
+    {
+        CHECK(static_cast<float>(vertex.position[3]) / 65535.F == 1.F);
+    }
+}
+
+TEST_CASE("Packed vertices unpack to within their precision", "[VertexPacking]")
+{
+    StaticMesh const original = makeMesh();
+    glm::vec3 const extent = glm::vec3 {original.aabb.max} - glm::vec3 {original.aabb.min};
+
+    for (VertexFormat format : {VertexFormat::ePacked, VertexFormat::eQuantized})
+    {
+        StaticMesh mesh = original;
+        packVertices(mesh, format);
+
+        CHECK(mesh.vertexFormat == format);
+        CHECK(mesh.vertices.empty());
+        CHECK(mesh.packedVertices.size() == original.vertices.size() * getVertexSize(format));
+
+        unpackVertices(mesh);
+        CHECK(mesh.vertexFormat == VertexFormat::eFull);
+        CHECK(mesh.packedVertices.empty());
+        REQUIRE(mesh.vertices.size() == original.vertices.size());
+
+        for (size_t i = 0; i < mesh.vertices.size(); i++)
+        {
+            INFO("Vertex " << i);
+
+            const StaticMeshVertex& expected = original.vertices[i];
+            const StaticMeshVertex& vertex = mesh.vertices[i];
+
+            // Half a step of 1/65535 of the AABB, with some room for rounding
+            float const precision = format == VertexFormat::eQuantized ? 1.F / 65535.F : 1e-6F;
+            for (int axis = 0; axis < 3; axis++)
+            {
+                CHECK(vertex.position[axis]
+                      == Catch::Approx(expected.position[axis]).margin(extent[axis] * precision));
+            }
+            CHECK(vertex.position.w == 1.F);
+
+            CHECK(angleBetween(glm::vec3 {vertex.normal}, glm::vec3 {expected.normal}) < 0.001F);
+            CHECK(angleBetween(glm::vec3 {vertex.tangent}, glm::vec3 {expected.tangent}) < 0.001F);
+            CHECK(angleBetween(glm::vec3 {vertex.bitangent}, glm::vec3 {expected.bitangent})
+                  < 0.002F);
+
+            CHECK(vertex.uv.x == Catch::Approx(expected.uv.x).margin(0.002F));
+            CHECK(vertex.uv.y == Catch::Approx(expected.uv.y).margin(0.001F));
+        }
+    }
+}